@@ -13,6 +13,7 @@
 #include "llvm/Support/Debug.h"
 
 #define UNDEF_VALUE "Undef"
+#define UNKNOWN_CALLEE "UnknownCallee"
 
 namespace ProgramInfo {
 
@@ -48,6 +49,132 @@ struct DebugVariableInfo {
     }
 };
 
+// Single backedge taken count expression with source variables it depends on
+struct IterationBound {
+    std::string iterations = UNDEF_VALUE;
+    std::vector<DebugVariableInfo> iterationsDebugInfo;
+
+    llvm::json::Object makeJson() const {
+        llvm::json::Object boundJson;
+        boundJson["iterations"] = iterations;
+
+        llvm::json::Array iterationsDbgInfoJson;
+        for (DebugVariableInfo const &dvi : iterationsDebugInfo) {
+            iterationsDbgInfoJson.push_back(std::move(dvi.makeJson()));
+        }
+        boundJson["iterations_debug_info"] = std::move(iterationsDbgInfoJson);
+        return boundJson;
+    }
+};
+
+// Loop iteration counts also for loops without single exact backedge taken count
+struct IterationBounds {
+    // Exact backedge taken count if loop exits through given exiting block
+    std::vector<std::pair<std::string, IterationBound>> exits;
+    IterationBound symbolicMax;
+    IterationBound constantMax;
+    // Trip counts as seen by loop unroller, 0 when unknown
+    unsigned int unrollTripCount = 0;
+    unsigned int unrollMaxTripCount = 0;
+    unsigned int unrollTripMultiple = 1;
+
+    llvm::json::Object makeJson() const {
+        llvm::json::Object boundsJson;
+
+        llvm::json::Array exitsJson;
+        for (auto const& [exitingBlock, bound] : exits) {
+            llvm::json::Object exitJson = bound.makeJson();
+            exitJson["exiting_block"] = exitingBlock;
+            exitsJson.push_back(std::move(exitJson));
+        }
+        boundsJson["exits"] = std::move(exitsJson);
+        boundsJson["symbolic_max"] = std::move(symbolicMax.makeJson());
+        boundsJson["constant_max"] = std::move(constantMax.makeJson());
+
+        llvm::json::Object unrollJson;
+        unrollJson["trip_count"] = unrollTripCount;
+        unrollJson["max_trip_count"] = unrollMaxTripCount;
+        unrollJson["trip_multiple"] = unrollTripMultiple;
+        boundsJson["unroll_estimate"] = std::move(unrollJson);
+        return boundsJson;
+    }
+};
+
+struct MemoryAccess {
+    std::string instruction;
+    std::string pointer;
+    // One of: "invariant", "unit-stride", "constant-stride",
+    // "invariant-stride", "indirect"
+    std::string pattern = UNDEF_VALUE;
+    std::string stride = UNDEF_VALUE;
+    unsigned int size = 0;
+    DebugLocation dbgLocation;
+    std::vector<DebugVariableInfo> pointerDebugInfo;
+
+    llvm::json::Object makeJson() const {
+        llvm::json::Object accessJson;
+        accessJson["instruction"] = instruction;
+        accessJson["pointer"] = pointer;
+        accessJson["pattern"] = pattern;
+        accessJson["stride"] = stride;
+        accessJson["size"] = size;
+        accessJson["dbg_location"] = std::move(dbgLocation.makeJson());
+
+        llvm::json::Array pointerDbgInfoJson;
+        for (DebugVariableInfo const &dvi : pointerDebugInfo) {
+            pointerDbgInfoJson.push_back(std::move(dvi.makeJson()));
+        }
+        accessJson["pointer_debug_info"] = std::move(pointerDbgInfoJson);
+        return accessJson;
+    }
+};
+
+// Instruction counts aggregated by source file and line
+struct SourceLineTable {
+    struct LineCost {
+        unsigned int instructions = 0;
+        // Instructions multiplied by constant trip counts of enclosing loops
+        double weightedInstructions = 0;
+        // False if any enclosing loop trip count was unknown and taken as 1
+        bool weightExact = true;
+    };
+    std::map<std::string, std::map<unsigned int, LineCost>> files;
+
+    void addInstruction(std::string file, unsigned int line, double weight, bool weightExact) {
+        LineCost &cost = files[file][line];
+        cost.instructions++;
+        cost.weightedInstructions += weight;
+        cost.weightExact &= weightExact;
+    }
+
+    // Adds costs of other table, ex. to aggregate functions of one module
+    void merge(const SourceLineTable &other) {
+        for (auto const& [file, lines] : other.files) {
+            std::map<unsigned int, LineCost> &fileLines = files[file];
+            for (auto const& [line, otherCost] : lines) {
+                LineCost &cost = fileLines[line];
+                cost.instructions += otherCost.instructions;
+                cost.weightedInstructions += otherCost.weightedInstructions;
+                cost.weightExact &= otherCost.weightExact;
+            }
+        }
+    }
+
+    // Each file is a table of [line, instructions, weighted instructions, weight exact] rows
+    llvm::json::Object makeJson() const {
+        llvm::json::Object filesJson;
+        for (auto const& [file, lines] : files) {
+            llvm::json::Array linesJson;
+            for (auto const& [line, cost] : lines) {
+                linesJson.push_back(llvm::json::Array{line, cost.instructions,
+                    cost.weightedInstructions, cost.weightExact ? 1 : 0});
+            }
+            filesJson[file] = std::move(linesJson);
+        }
+        return filesJson;
+    }
+};
+
 // classes and structures
 struct ProgramPart {
     std::vector<std::shared_ptr<ProgramPart>> children;
@@ -73,6 +200,10 @@ struct Function : ProgramPart {
         std::string type;
     };
     std::vector<Argument> arguments;
+    // Set when function was not analyzed, ex. because of exceeded analysis budget
+    bool skipped = false;
+    // Printed separately by source lines printer, not part of function json
+    SourceLineTable sourceLines;
 
     void addArgument(std::string name, std::string type) {
         Argument a;
@@ -81,6 +212,10 @@ struct Function : ProgramPart {
         arguments.push_back(a);
     }
 
+    void setSkipped() {
+        skipped = true;
+    }
+
     // friend class FunctionInfoHelper;
 
     // bool operator=(const Function &o) const {
@@ -118,6 +253,10 @@ struct Function : ProgramPart {
         }
         functionJson["arguments"] = std::move(argumentsJson);
 
+        if (skipped) {
+            functionJson["skipped"] = true;
+        }
+
         if (!children.empty()) {
             llvm::json::Array childrenJson;
             for (std::shared_ptr<ProgramPart> const &pp : children) {
@@ -129,18 +268,42 @@ struct Function : ProgramPart {
     }
 };
 
+// Call instruction, one per possible callee for indirect calls
+struct CallSite {
+    Function callee;
+    // One of: "direct", "indirect", "parallel", "inline_asm"
+    std::string kind = "direct";
+    std::string probability = "1";
+    // Number of threads running outlined function, for parallel calls
+    std::string threads = UNDEF_VALUE;
+
+    CallSite(std::string kind = "direct", std::string probability = "1")
+        : kind(kind), probability(probability) {}
+
+    llvm::json::Object makeJson() const {
+        llvm::json::Object callJson;
+        callJson["function"] = std::move(callee.makeJson());
+        callJson["call_kind"] = kind;
+        callJson["probability"] = probability;
+        if (kind == "parallel") {
+            callJson["threads"] = threads;
+        }
+        return callJson;
+    }
+};
+
 struct Block : ProgramPart {
     std::map<std::string, std::string> successors;
     std::map<std::string, unsigned int> instructions;
-    std::vector<Function> callInstructions;
+    std::vector<CallSite> callInstructions;
     DebugLocation terminatorDbgLocation;
 
     void addInstruction(std::string name) {
         instructions[name]++;
     }
 
-    void addCallInstruction(Function f) {
-        callInstructions.push_back(f);
+    void addCallInstruction(CallSite c) {
+        callInstructions.push_back(c);
     }
 
     void addSuccessor(std::string blockName, std::string probability) {
@@ -182,11 +345,8 @@ struct Block : ProgramPart {
         bbJson["instructions"] = std::move(instructionsJson);
 
         llvm::json::Array callsJson;
-        for (Function const &function : callInstructions) {
-            llvm::json::Object functionJson;
-            functionJson["function"] = std::move(function.makeJson());
-
-            callsJson.push_back(std::move(functionJson));
+        for (CallSite const &callSite : callInstructions) {
+            callsJson.push_back(std::move(callSite.makeJson()));
         }
         bbJson["function calls"] = std::move(callsJson);
 
@@ -209,7 +369,13 @@ struct Block : ProgramPart {
 struct Loop : ProgramPart {
     std::string iterations;
     std::vector<DebugVariableInfo> iterationsDebugInfo;
+    IterationBounds iterationBounds;
 
+    // Memory footprint, filled only when memory access analysis is enabled
+    bool memoryFootprintAnalyzed = false;
+    std::vector<MemoryAccess> memoryAccesses;
+    std::string bytesPerIteration = UNDEF_VALUE;
+    std::string bytesTotal = UNDEF_VALUE;
 
     void setIterationCount(std::string iterationCount) {
         iterations = iterationCount;
@@ -219,6 +385,20 @@ struct Loop : ProgramPart {
         this->iterationsDebugInfo = iterationsDebugInfo;
     }
 
+    void setIterationBounds(IterationBounds bounds) {
+        iterationBounds = bounds;
+    }
+
+    void addMemoryAccess(MemoryAccess access) {
+        memoryAccesses.push_back(access);
+    }
+
+    void setMemoryFootprint(std::string perIteration, std::string total) {
+        memoryFootprintAnalyzed = true;
+        bytesPerIteration = perIteration;
+        bytesTotal = total;
+    }
+
     virtual void print(std::stringstream &ss, int indent_level = 0) override {
 
     }
@@ -235,6 +415,20 @@ struct Loop : ProgramPart {
             iterationsDbgInfoJson.push_back(std::move(i.makeJson()));
         }
         loopJson["iterations_debug_info"] = std::move(iterationsDbgInfoJson);
+        loopJson["iterations_bounds"] = std::move(iterationBounds.makeJson());
+
+        if (memoryFootprintAnalyzed) {
+            llvm::json::Array accessesJson;
+            for (MemoryAccess const &access : memoryAccesses) {
+                accessesJson.push_back(std::move(access.makeJson()));
+            }
+            loopJson["memory_accesses"] = std::move(accessesJson);
+
+            llvm::json::Object footprintJson;
+            footprintJson["bytes_per_iteration"] = bytesPerIteration;
+            footprintJson["bytes_total"] = bytesTotal;
+            loopJson["memory_footprint"] = std::move(footprintJson);
+        }
 
         if (!children.empty()) {
             llvm::json::Array childrenJson;
@@ -13,6 +13,8 @@ class LoopInfo;
 class ScalarEvolution;
 class SCEV;
 class Function;
+class CallBase;
+class Module;
 
 namespace json {
 class Object;
@@ -28,6 +30,10 @@ public:
 
   Result run(llvm::Function &F, llvm::FunctionAnalysisManager &AM);
 
+  // Function with name and arguments only, marked as not analyzed. Returned
+  // by run for functions without debug info required by analysis.
+  static Result makeSkippedFunction(llvm::Function &F);
+
 private:
   llvm::BranchProbabilityInfo *BPI;
   llvm::LoopInfo *LI;
@@ -44,13 +50,26 @@ private:
   // };
   std::vector<llvm::Value*> functionArguments;
   std::map<std::string, ProgramInfo::DebugVariableInfo> debugValueMap;
-
-  void createDebugInfoMap();
+  // Bytes touched by whole loop, used as per iteration cost of parent loop
+  std::map<const llvm::Loop *, const llvm::SCEV *> loopMemoryFootprints;
+  ProgramInfo::SourceLineTable sourceLines;
+  // Functions by their profile name hash, for resolving value profiled indirect calls.
+  // Built once per module, on first indirect call with value profile.
+  const llvm::Module *profiledCalleesModule = nullptr;
+  std::map<uint64_t, llvm::Function *> profiledCallees;
+
+  bool createDebugInfoMap(std::string &reason);
   void trackValue(llvm::Value* val);
   std::vector<ProgramInfo::DebugVariableInfo> getScevDebugInfo(const llvm::SCEV *s);
   std::vector<ProgramInfo::DebugVariableInfo> getScevDebugInfo(const llvm::SCEV *s, std::vector<ProgramInfo::DebugVariableInfo> &iterationsDebugInfo);
   std::shared_ptr<ProgramInfo::Loop> handleLoop(const llvm::Loop &L);
+  ProgramInfo::IterationBound getIterationBound(const llvm::SCEV *s);
+  ProgramInfo::IterationBounds getIterationBounds(const llvm::Loop &L);
+  void handleLoopMemoryAccesses(const llvm::Loop &L, ProgramInfo::Loop &infoLoop);
   std::shared_ptr<ProgramInfo::Block> handleBB(llvm::BasicBlock &BB);
+  void handleCall(llvm::CallBase &call, ProgramInfo::Block &infoBlock);
+  void handleIndirectCall(llvm::CallBase &call, ProgramInfo::Block &infoBlock);
+  void handleParallelCall(llvm::CallBase &call, ProgramInfo::Block &infoBlock);
 };
 
 /// Printer pass for the \c ProgramComplexity results.
@@ -66,4 +85,31 @@ public:
                               llvm::FunctionAnalysisManager &AM);
 };
 
+/// Module printer pass for the \c ProgramComplexity instruction counts
+/// aggregated by source line over all functions of module. Prints one compact
+/// json object with table per source file.
+class ProgramComplexityLinesPrinterPass
+    : public llvm::PassInfoMixin<ProgramComplexityLinesPrinterPass> {
+  llvm::raw_ostream &OS;
+
+public:
+  explicit ProgramComplexityLinesPrinterPass(llvm::raw_ostream &OS) : OS(OS) {}
+
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &AM);
+};
+
+/// Module printer pass for the \c ProgramComplexity results. Functions are
+/// analyzed from the hottest one, until time or function count budget runs
+/// out. Functions left are printed marked as skipped.
+class ProgramComplexityBudgetedPrinterPass
+    : public llvm::PassInfoMixin<ProgramComplexityBudgetedPrinterPass> {
+  llvm::raw_ostream &OS;
+
+public:
+  explicit ProgramComplexityBudgetedPrinterPass(llvm::raw_ostream &OS)
+      : OS(OS) {}
+
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &AM);
+};
+
 #endif // PROGRAMCOMPLEXITY_H
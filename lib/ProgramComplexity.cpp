@@ -12,9 +12,12 @@
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/ValueSymbolTable.h"
+#include "llvm/ProfileData/InstrProf.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/Path.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace llvm;
@@ -29,20 +32,39 @@ static cl::opt<bool> UseBranchProbability(
     cl::desc("ProgramComplexity: Use branch probability info form "
              "BranchProbabilityAnalysis, for branches probabilities."));
 
+static const uint32_t MaxIndirectCallCandidates = 16;
 
-void ProgramComplexity::createDebugInfoMap() {
-  // Link debug info to variables in code
+static cl::opt<bool> AnalyzeMemoryFootprint(
+    "analyze-memory-footprint", cl::init(false), cl::Hidden,
+    cl::desc("ProgramComplexity: Classify load/store accesses in loops by "
+             "their SCEV stride and estimate bytes touched by each loop."));
+
+
+bool ProgramComplexity::createDebugInfoMap(std::string &reason) {
+  // Link debug info to variables in code. Returns false with reason set when
+  // function debug info does not meet analysis requirements.
   DebugInfoFinder dif;
 
   DISubprogram *sp = F->getSubprogram();
-  assert(sp && "input LLVM IR has to be compiled in debug mode (clang -g option, debug llvm build)");
+  if (!sp) {
+    // Input LLVM IR has to be compiled in debug mode (clang -g option)
+    reason = "no debug info";
+    return false;
+  }
 
   dif.processSubprogram(sp);
 
   // Source file checksum
-  assert(dif.compile_unit_count() == 1 && "Not a single compile unit");
+  if (dif.compile_unit_count() != 1) {
+    reason = "not a single compile unit";
+    return false;
+  }
   for(DICompileUnit *cu : dif.compile_units()) {
-    DIFile *file = dyn_cast<DIFile>(cu->getOperand(0));
+    DIFile *file = dyn_cast_or_null<DIFile>(cu->getOperand(0));
+    if (!file || !file->getChecksum()) {
+      reason = "source file without checksum";
+      return false;
+    }
     sourceFileChecksum = file->getChecksum()->Value;
     // TODO: assign checksum to output json. Should be genrated for module instead of pef function?
   }
@@ -51,9 +73,8 @@ void ProgramComplexity::createDebugInfoMap() {
   for (DILocalVariable *lv : dif.local_variables()) {
     MetadataAsValue *mav = MetadataAsValue::getIfExists(F->getContext(), lv);
     if (!mav) {
-      // TODO: check this case when it happens and decide what to do. Probably just continue.
-      assert(0 && "Can't get Value from DILocalVariable.");
-      //continue;
+      reason = "no debug intrinsic for variable " + lv->getName().str();
+      return false;
     }
 
     for(Value* mavUser : mav->users()) {
@@ -78,7 +99,8 @@ void ProgramComplexity::createDebugInfoMap() {
         };
       }
       else {
-        assert(false && "User of metadata should be a debug info intrinsic instruction.");
+        reason = "variable " + lv->getName().str() + " used outside of debug intrinsic";
+        return false;
       }
     }
   }
@@ -118,6 +140,8 @@ void ProgramComplexity::createDebugInfoMap() {
     // }
   }
   */
+
+  return true;
 }
 
 void ProgramComplexity::trackValue(Value* inst) {
@@ -126,6 +150,16 @@ void ProgramComplexity::trackValue(Value* inst) {
 
 std::vector<ProgramInfo::DebugVariableInfo> ProgramComplexity::getScevDebugInfo(const SCEV* scev) {
   std::vector<ProgramInfo::DebugVariableInfo> iterationsDebugInfo = {};
+
+  // Whole SCEV can be a single variable, ex. loop bound given as argument
+  if (const SCEVUnknown *unknownS = dyn_cast<SCEVUnknown>(scev)) {
+    std::string valName = unknownS->getValue()->getNameOrAsOperand();
+    if (debugValueMap.count(valName)) {
+      iterationsDebugInfo.push_back(debugValueMap[valName]);
+    }
+    return iterationsDebugInfo;
+  }
+
   return getScevDebugInfo(scev, iterationsDebugInfo);
 }
 
@@ -159,21 +193,45 @@ std::vector<ProgramInfo::DebugVariableInfo> ProgramComplexity::getScevDebugInfo(
 }
 
 
+ProgramComplexity::Result ProgramComplexity::makeSkippedFunction(Function &F) {
+  std::shared_ptr<ProgramInfo::Function> infoFunction = std::make_shared<ProgramInfo::Function>();
+  infoFunction->setName(F.getNameOrAsOperand());
+  for (Argument &A : F.args()) {
+    std::string typeStr;
+    llvm::raw_string_ostream OS(typeStr);
+    A.getType()->print(OS);
+    infoFunction->addArgument(A.getNameOrAsOperand(), typeStr);
+  }
+  infoFunction->setSkipped();
+  return infoFunction;
+}
+
 ProgramComplexity::Result ProgramComplexity::run(Function &F,
                                                  FunctionAnalysisManager &AM) {
   this->F = &F;
 
+  // Analysis object is reused for every function, reset per function state
+  visitedBlocks.clear();
+  functionArguments.clear();
+  debugValueMap.clear();
+  loopMemoryFootprints.clear();
+  sourceLines = ProgramInfo::SourceLineTable();
+
   for (Value* op : F.operands()) {
     functionArguments.push_back(op);
   }
 
+  std::string skipReason;
+  if (!createDebugInfoMap(skipReason)) {
+    LLVM_DEBUG(dbgs() << "Skipping function " << F.getName() << ": " << skipReason << "\n");
+    return makeSkippedFunction(F);
+  }
+
   // Get required analysis
   BPI = &AM.getResult<BranchProbabilityAnalysis>(F);
   LI = &AM.getResult<LoopAnalysis>(F);
   SE = &AM.getResult<ScalarEvolutionAnalysis>(F);
 
-  createDebugInfoMap();
-
   LLVM_DEBUG(
     dbgs() << "FUNCTION: " << F.getName() << "( ";
     for (Argument &A : F.args()) {
@@ -214,6 +272,8 @@ ProgramComplexity::Result ProgramComplexity::run(Function &F,
     }
   }
 
+  infoFunction->sourceLines = std::move(sourceLines);
+
   return infoFunction;
 }
 
@@ -249,6 +309,13 @@ std::shared_ptr<ProgramInfo::Loop> ProgramComplexity::handleLoop(const Loop &L)
     infoLoop->setIterationCount("Undef");
   }
 
+  // Bounds are available also for multi exit and data dependent loops
+  infoLoop->setIterationBounds(getIterationBounds(L));
+
+  if (AnalyzeMemoryFootprint) {
+    handleLoopMemoryAccesses(L, *infoLoop);
+  }
+
   // Go through basic blocks in loop
   LLVM_DEBUG(dbgs() << "Handling BBs in loop: " << loopName << "\n");
   for (BasicBlock *BB : L.getBlocks()) {
@@ -262,15 +329,339 @@ std::shared_ptr<ProgramInfo::Loop> ProgramComplexity::handleLoop(const Loop &L)
   return infoLoop;
 }
 
+ProgramInfo::IterationBound ProgramComplexity::getIterationBound(const SCEV *s) {
+  ProgramInfo::IterationBound bound;
+  if (isa<SCEVCouldNotCompute>(s)) {
+    return bound;
+  }
+
+  std::string scevStr;
+  llvm::raw_string_ostream OS(scevStr);
+  if (const SCEVConstant *constS = dyn_cast<SCEVConstant>(s)) {
+    // Backedge taken counts are unsigned, SCEV prints constants as signed
+    constS->getAPInt().print(OS, /*isSigned*/ false);
+  }
+  else {
+    s->print(OS);
+  }
+  bound.iterations = OS.str();
+  bound.iterationsDebugInfo = getScevDebugInfo(s);
+  return bound;
+}
+
+ProgramInfo::IterationBounds ProgramComplexity::getIterationBounds(const Loop &L) {
+  ProgramInfo::IterationBounds bounds;
+
+  SmallVector<BasicBlock *, 4> exitingBlocks;
+  L.getExitingBlocks(exitingBlocks);
+  for (BasicBlock *exitingBlock : exitingBlocks) {
+    const SCEV *exitCount = SE->getExitCount(&L, exitingBlock);
+    bounds.exits.push_back({exitingBlock->getNameOrAsOperand(), getIterationBound(exitCount)});
+  }
+
+  bounds.symbolicMax = getIterationBound(SE->getSymbolicMaxBackedgeTakenCount(&L));
+  bounds.constantMax = getIterationBound(SE->getConstantMaxBackedgeTakenCount(&L));
+
+  bounds.unrollTripCount = SE->getSmallConstantTripCount(&L);
+  bounds.unrollMaxTripCount = SE->getSmallConstantMaxTripCount(&L);
+  bounds.unrollTripMultiple = SE->getSmallConstantTripMultiple(&L);
+
+  LLVM_DEBUG(dbgs() << "Loop iteration bounds: symbolic max " << bounds.symbolicMax.iterations
+                    << ", constant max " << bounds.constantMax.iterations << "\n");
+  return bounds;
+}
+
+void ProgramComplexity::handleLoopMemoryAccesses(const Loop &L, ProgramInfo::Loop &infoLoop) {
+  // Classify each load/store directly in loop (not in subloops) by add recurrence of its pointer
+  // and estimate bytes touched. Subloops are handled before, their whole loop footprint is
+  // counted once per iteration of this loop.
+  const DataLayout &DL = F->getParent()->getDataLayout();
+  Type *int64Ty = Type::getInt64Ty(F->getContext());
+
+  const SCEV *invariantBytes = SE->getZero(int64Ty);
+  const SCEV *variantBytes = SE->getZero(int64Ty);
+
+  for (BasicBlock *BB : L.getBlocks()) {
+    if (LI->getLoopFor(BB) != &L) {
+      continue;
+    }
+
+    for (Instruction &Inst : *BB) {
+      Value *pointer = getLoadStorePointerOperand(&Inst);
+      if (!pointer) {
+        continue;
+      }
+      Type *accessTy = isa<LoadInst>(Inst) ? Inst.getType()
+                                           : cast<StoreInst>(Inst).getValueOperand()->getType();
+
+      ProgramInfo::MemoryAccess access;
+      access.instruction = Inst.getOpcodeName();
+      access.pointer = pointer->getNameOrAsOperand();
+      access.size = DL.getTypeStoreSize(accessTy).getKnownMinValue();
+
+      const SCEV *pointerScev = SE->getSCEVAtScope(pointer, &L);
+      const SCEV *accessBytes = SE->getConstant(int64Ty, access.size);
+
+      if (SE->isLoopInvariant(pointerScev, &L)) {
+        // Same address every iteration, touched once for whole loop
+        access.pattern = "invariant";
+        access.stride = "0";
+        invariantBytes = SE->getAddExpr(invariantBytes, accessBytes);
+      }
+      else {
+        const SCEVAddRecExpr *addRec = dyn_cast<SCEVAddRecExpr>(pointerScev);
+        if (addRec && addRec->getLoop() == &L && addRec->isAffine()) {
+          const SCEV *step = addRec->getStepRecurrence(*SE);
+
+          std::string stepStr;
+          raw_string_ostream OS(stepStr);
+          step->print(OS);
+          access.stride = stepStr;
+
+          const SCEVConstant *constStep = dyn_cast<SCEVConstant>(step);
+          if (!constStep) {
+            // Step is unknown at compile time but fixed for whole loop
+            access.pattern = "invariant-stride";
+          }
+          else if (constStep->getAPInt().abs() == access.size) {
+            access.pattern = "unit-stride";
+          }
+          else {
+            access.pattern = "constant-stride";
+          }
+        }
+        else {
+          // Address depends on loaded data or non affine expression
+          access.pattern = "indirect";
+        }
+        variantBytes = SE->getAddExpr(variantBytes, accessBytes);
+      }
+
+      if (DILocation *loc = Inst.getDebugLoc().get()) {
+        if (loc->getLine() != 0) {
+          access.dbgLocation.line = std::to_string(loc->getLine());
+        }
+        if (loc->getColumn() != 0) {
+          access.dbgLocation.column = std::to_string(loc->getColumn());
+        }
+      }
+      access.pointerDebugInfo = getScevDebugInfo(pointerScev);
+
+      infoLoop.addMemoryAccess(access);
+    }
+  }
+
+  // Subloops footprints are touched again in every iteration of this loop
+  bool footprintKnown = true;
+  for (Loop *subLoop : L.getSubLoops()) {
+    const SCEV *subLoopBytes = loopMemoryFootprints.count(subLoop) ? loopMemoryFootprints[subLoop] : nullptr;
+    if (!subLoopBytes || !SE->isLoopInvariant(subLoopBytes, &L)) {
+      footprintKnown = false;
+      continue;
+    }
+    variantBytes = SE->getAddExpr(variantBytes, subLoopBytes);
+  }
+
+  const SCEV *bytesPerIteration = SE->getAddExpr(invariantBytes, variantBytes);
+  const SCEV *bytesTotal = nullptr;
+  if (footprintKnown && SE->hasLoopInvariantBackedgeTakenCount(&L)) {
+    const SCEV *backedgeTakenCount = SE->getBackedgeTakenCount(&L);
+    if (!isa<SCEVCouldNotCompute>(backedgeTakenCount)) {
+      const SCEV *tripCount = SE->getAddExpr(SE->getTruncateOrZeroExtend(backedgeTakenCount, int64Ty),
+                                             SE->getOne(int64Ty));
+      bytesTotal = SE->getAddExpr(invariantBytes, SE->getMulExpr(tripCount, variantBytes));
+      loopMemoryFootprints[&L] = bytesTotal;
+    }
+  }
+
+  std::string perIterationStr;
+  raw_string_ostream perIterationOS(perIterationStr);
+  if (footprintKnown) {
+    bytesPerIteration->print(perIterationOS);
+  }
+  else {
+    perIterationOS << UNDEF_VALUE;
+  }
+
+  std::string totalStr;
+  raw_string_ostream totalOS(totalStr);
+  if (bytesTotal) {
+    bytesTotal->print(totalOS);
+  }
+  else {
+    totalOS << UNDEF_VALUE;
+  }
+
+  LLVM_DEBUG(dbgs() << "Loop memory footprint: " << perIterationOS.str() << " bytes per iteration, "
+                    << totalOS.str() << " bytes total\n");
+  infoLoop.setMemoryFootprint(perIterationOS.str(), totalOS.str());
+}
+
+static void addCallArguments(ProgramInfo::Function &f, CallBase &call, unsigned int firstArg = 0) {
+  // special case for call instruction - tell which function is called
+  for (unsigned int i = firstArg; i < call.arg_size(); i++) {
+    llvm::Value * arg = call.getArgOperand(i);
+
+    std::string result;
+    raw_string_ostream OS(result);
+    arg->getType()->print(OS, true);
+
+    std::string variableName = arg->getNameOrAsOperand();
+
+    f.addArgument(
+      variableName,
+      result);
+  }
+}
+
+void ProgramComplexity::handleCall(CallBase &call, ProgramInfo::Block &infoBlock) {
+  if (call.isInlineAsm()) {
+    ProgramInfo::CallSite callSite("inline_asm");
+    callSite.callee.setName("asm");
+    addCallArguments(callSite.callee, call);
+    infoBlock.addCallInstruction(callSite);
+    return;
+  }
+
+  // Callee can be hidden behind pointer cast
+  Function *callee = dyn_cast<Function>(call.getCalledOperand()->stripPointerCasts());
+  if (!callee) {
+    handleIndirectCall(call, infoBlock);
+    return;
+  }
+
+  if (callee->getName() == "__kmpc_fork_call" || callee->getName() == "__kmpc_fork_teams") {
+    handleParallelCall(call, infoBlock);
+    return;
+  }
+
+  ProgramInfo::CallSite callSite;
+  callSite.callee.setName(callee->getNameOrAsOperand());
+  addCallArguments(callSite.callee, call);
+  infoBlock.addCallInstruction(callSite);
+}
+
+void ProgramComplexity::handleIndirectCall(CallBase &call, ProgramInfo::Block &infoBlock) {
+  // Possible callees with their probabilities, sum of probabilities is at most 1
+  std::vector<std::pair<Function *, double>> candidates;
+  // Share of calls going to targets not resolved to any function. Counted in
+  // integers, so rounding can't leave tiny probability of unknown callee.
+  uint64_t unknownCount = 1;
+  uint64_t totalCount = 1;
+
+  if (MDNode *calleesMD = call.getMetadata(LLVMContext::MD_callees)) {
+    // Complete set of possible callees, without probabilities
+    for (const MDOperand &op : calleesMD->operands()) {
+      if (Function *candidate = mdconst::dyn_extract_or_null<Function>(op)) {
+        candidates.push_back({candidate, 0});
+      }
+    }
+    for (auto &candidate : candidates) {
+      candidate.second = 1.0 / candidates.size();
+    }
+    unknownCount = candidates.empty() ? 1 : 0;
+  }
+  else {
+    uint32_t valueDataCount = 0;
+    uint64_t profiledCount = 0;
+    InstrProfValueData valueData[MaxIndirectCallCandidates];
+    if (getValueProfDataFromInst(call, IPVK_IndirectCallTarget, MaxIndirectCallCandidates,
+                                 valueData, valueDataCount, profiledCount) && profiledCount) {
+      Module *M = F->getParent();
+      if (profiledCalleesModule != M) {
+        profiledCallees.clear();
+        for (Function &candidate : *M) {
+          profiledCallees[IndexedInstrProf::ComputeHash(getPGOFuncName(candidate))] = &candidate;
+          profiledCallees[candidate.getGUID()] = &candidate;
+        }
+        profiledCalleesModule = M;
+      }
+
+      totalCount = unknownCount = profiledCount;
+      for (uint32_t i = 0; i < valueDataCount; i++) {
+        auto it = profiledCallees.find(valueData[i].Value);
+        if (it == profiledCallees.end()) {
+          continue;
+        }
+        candidates.push_back({it->second, double(valueData[i].Count) / totalCount});
+        unknownCount -= std::min(unknownCount, valueData[i].Count);
+      }
+    }
+  }
+
+  for (auto const &[candidate, probability] : candidates) {
+    ProgramInfo::CallSite callSite("indirect", std::to_string(probability));
+    callSite.callee.setName(candidate->getNameOrAsOperand());
+    addCallArguments(callSite.callee, call);
+    infoBlock.addCallInstruction(callSite);
+  }
+
+  if (unknownCount > 0) {
+    // Callee not known, or part of profiled calls went to not resolved targets
+    ProgramInfo::CallSite callSite("indirect", candidates.empty()
+        ? "1" : std::to_string(double(unknownCount) / totalCount));
+    callSite.callee.setName(UNKNOWN_CALLEE);
+    addCallArguments(callSite.callee, call);
+    infoBlock.addCallInstruction(callSite);
+  }
+}
+
+void ProgramComplexity::handleParallelCall(CallBase &call, ProgramInfo::Block &infoBlock) {
+  // OpenMP parallel region: __kmpc_fork_call(ident, argc, microtask, args...)
+  // Outlined microtask is run by every thread in team, with shared args passed after it.
+  ProgramInfo::CallSite callSite("parallel");
+  Function *outlined = call.arg_size() > 2
+      ? dyn_cast<Function>(call.getArgOperand(2)->stripPointerCasts()) : nullptr;
+  callSite.callee.setName(outlined ? outlined->getNameOrAsOperand() : UNKNOWN_CALLEE);
+  addCallArguments(callSite.callee, call, 3);
+
+  // num_threads clause is passed by preceding __kmpc_push_num_threads(ident, gtid, threads) call
+  callSite.threads = "OMPNumThreads";
+  for (Instruction *I = call.getPrevNode(); I; I = I->getPrevNode()) {
+    CallBase *prevCall = dyn_cast<CallBase>(I);
+    Function *prevCallee = prevCall ? prevCall->getCalledFunction() : nullptr;
+    if (!prevCallee) {
+      continue;
+    }
+    if (prevCallee->getName() == "__kmpc_push_num_threads" && prevCall->arg_size() > 2) {
+      Value *threads = prevCall->getArgOperand(2);
+      if (ConstantInt *constThreads = dyn_cast<ConstantInt>(threads)) {
+        callSite.threads = std::to_string(constThreads->getZExtValue());
+      }
+      else {
+        callSite.threads = threads->getNameOrAsOperand();
+      }
+      break;
+    }
+    if (prevCallee->getName().starts_with("__kmpc_fork")) {
+      break;
+    }
+  }
+
+  infoBlock.addCallInstruction(callSite);
+}
+
 std::shared_ptr<ProgramInfo::Block> ProgramComplexity::handleBB(BasicBlock &BB) {
   std::string bbName = BB.getNameOrAsOperand();
 
   std::shared_ptr<ProgramInfo::Block> infoBlock = std::make_shared<ProgramInfo::Block>();
   infoBlock->setName(bbName);
 
+  // Weight of instructions in source line costs, product of constant trip counts of enclosing loops
+  double tripWeight = 1;
+  bool tripWeightExact = true;
+  for (Loop *L = LI->getLoopFor(&BB); L; L = L->getParentLoop()) {
+    if (unsigned tripCount = SE->getSmallConstantTripCount(L)) {
+      tripWeight *= tripCount;
+    }
+    else {
+      tripWeightExact = false;
+    }
+  }
+
   // Handle instructions inside block
   for (Instruction &Inst : BB) {
-    if (CallInst *callInst = dyn_cast<CallInst>(&Inst)) {
+    if (CallBase *callInst = dyn_cast<CallBase>(&Inst)) {
       // Handle call instruction
 
       // Ignore annotation intrinsics (debug, lifetime)
@@ -280,28 +671,22 @@ std::shared_ptr<ProgramInfo::Block> ProgramComplexity::handleBB(BasicBlock &BB)
         }
       }
 
-      ProgramInfo::Function f;
-      f.setName(callInst->getCalledFunction()->getNameOrAsOperand());
-
-      // special case for call instruction - tell which function is called
-      for (unsigned int i = 0; i < callInst->getNumOperands() - 1; i++) {
-        llvm::Value * arg = callInst->getOperand(i);
-
-        std::string result;
-        raw_string_ostream OS(result);
-        arg->getType()->print(OS, true);
-
-        std::string variableName = arg->getNameOrAsOperand();
-
-        f.addArgument(
-          variableName,
-          result);
-      }
-      infoBlock->addCallInstruction(f);
+      handleCall(*callInst, *infoBlock);
 
     } else {
       infoBlock->addInstruction(Inst.getOpcodeName());
     }
+
+    // Attribute instruction to its source line
+    if (DILocation *loc = Inst.getDebugLoc().get()) {
+      if (loc->getLine() != 0) {
+        std::string file = loc->getFilename().str();
+        if (!loc->getDirectory().empty() && !sys::path::is_absolute(file)) {
+          file = (loc->getDirectory() + "/" + file).str();
+        }
+        sourceLines.addInstruction(file, loc->getLine(), tripWeight, tripWeightExact);
+      }
+    }
   }
 
   LLVM_DEBUG(
@@ -313,12 +698,12 @@ std::shared_ptr<ProgramInfo::Block> ProgramComplexity::handleBB(BasicBlock &BB)
 
   LLVM_DEBUG(
     dbgs() << "calls in bb:\n";
-    for(ProgramInfo::Function function : infoBlock->callInstructions) {
-      dbgs() << function.name << "( ";
-      for(ProgramInfo::Function::Argument arg : function.arguments) {
+    for(ProgramInfo::CallSite callSite : infoBlock->callInstructions) {
+      dbgs() << callSite.callee.name << "( ";
+      for(ProgramInfo::Function::Argument arg : callSite.callee.arguments) {
         dbgs() << arg.type << ": " << arg.name << ", ";
       }
-      dbgs() << ")\n";
+      dbgs() << ") " << callSite.kind << ", probability: " << callSite.probability << "\n";
     }
   );
 
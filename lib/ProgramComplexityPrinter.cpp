@@ -2,6 +2,7 @@
 #include "ProgramComplexity.h"
 #include "llvm/ADT/DepthFirstIterator.h"
 #include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/Analysis/ScalarEvolution.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/IR/InstIterator.h"
@@ -12,7 +13,10 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/JSON.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <optional>
 
 using namespace llvm;
 
@@ -20,6 +24,18 @@ using namespace llvm;
 
 AnalysisKey ProgramComplexityPrinterPass::Key;
 
+// Budgeted printer options
+static cl::opt<unsigned> FunctionBudget(
+    "complexity-function-budget", cl::init(0),
+    cl::desc("ProgramComplexity: Maximal number of functions analyzed by "
+             "print-program-complexity-budgeted pass, 0 means no limit."));
+
+static cl::opt<unsigned> TimeBudget(
+    "complexity-time-budget", cl::init(0),
+    cl::desc("ProgramComplexity: Time in milliseconds after which "
+             "print-program-complexity-budgeted pass stops analyzing "
+             "functions, 0 means no limit."));
+
 PreservedAnalyses
 ProgramComplexityPrinterPass::run(Function &F, FunctionAnalysisManager &AM) {
   ProgramComplexity::Result result = AM.getResult<ProgramComplexity>(F);
@@ -31,6 +47,134 @@ ProgramComplexityPrinterPass::run(Function &F, FunctionAnalysisManager &AM) {
   return PreservedAnalyses::all();
 }
 
+PreservedAnalyses
+ProgramComplexityLinesPrinterPass::run(Module &M, ModuleAnalysisManager &AM) {
+  FunctionAnalysisManager &FAM =
+      AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+
+  // Inlined code of one source line may be spread over many functions
+  ProgramInfo::SourceLineTable moduleLines;
+  for (Function &F : M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    moduleLines.merge(FAM.getResult<ProgramComplexity>(F)->sourceLines);
+
+    // Only line costs are kept, free analyses to bound memory use
+    FAM.clear(F, F.getName());
+  }
+
+  json::Object linesJson;
+  linesJson["module"] = M.getModuleIdentifier();
+  linesJson["files"] = std::move(moduleLines.makeJson());
+
+  json::OStream JOS(OS);
+  JOS.value(std::move(linesJson));
+  OS << '\n';
+
+  return PreservedAnalyses::all();
+}
+
+namespace {
+struct FunctionHotness {
+  Function *F;
+  // Profile entry count, present only for modules with profile summary
+  std::optional<uint64_t> entryCount;
+  // Static call graph estimate, number of direct call sites
+  uint64_t callSites = 0;
+  size_t size = 0;
+
+  bool operator<(const FunctionHotness &o) const {
+    // Hotter function goes first
+    if (entryCount.has_value() != o.entryCount.has_value()) {
+      return entryCount.has_value();
+    }
+    if (entryCount.has_value() && *entryCount != *o.entryCount) {
+      return *entryCount > *o.entryCount;
+    }
+    if (callSites != o.callSites) {
+      return callSites > o.callSites;
+    }
+    return size > o.size;
+  }
+};
+} // namespace
+
+PreservedAnalyses
+ProgramComplexityBudgetedPrinterPass::run(Module &M, ModuleAnalysisManager &AM) {
+  auto startTime = std::chrono::steady_clock::now();
+
+  FunctionAnalysisManager &FAM =
+      AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+  ProfileSummaryInfo &PSI = AM.getResult<ProfileSummaryAnalysis>(M);
+
+  std::vector<FunctionHotness> functions;
+  for (Function &F : M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+
+    FunctionHotness hotness;
+    hotness.F = &F;
+    hotness.size = F.getInstructionCount();
+    if (PSI.hasProfileSummary()) {
+      if (auto entryCount = F.getEntryCount()) {
+        hotness.entryCount = entryCount->getCount();
+      }
+    }
+    functions.push_back(hotness);
+  }
+
+  // Without profile, rank functions by number of their call sites. Only IR is
+  // scanned, no function analysis runs before budget is checked.
+  bool needsStaticHotness = std::any_of(functions.begin(), functions.end(),
+      [](const FunctionHotness &h) { return !h.entryCount.has_value(); });
+  if (needsStaticHotness) {
+    DenseMap<const Function *, uint64_t> callSites;
+    for (FunctionHotness &caller : functions) {
+      for (Instruction &I : instructions(*caller.F)) {
+        if (CallBase *call = dyn_cast<CallBase>(&I)) {
+          if (Function *callee = call->getCalledFunction()) {
+            callSites[callee]++;
+          }
+        }
+      }
+    }
+    for (FunctionHotness &h : functions) {
+      h.callSites = callSites.lookup(h.F);
+    }
+  }
+
+  std::stable_sort(functions.begin(), functions.end());
+
+  unsigned analyzedFunctions = 0;
+  for (FunctionHotness &h : functions) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    bool budgetExceeded = (FunctionBudget && analyzedFunctions >= FunctionBudget) ||
+                          (TimeBudget && elapsed.count() >= TimeBudget);
+
+    ProgramComplexity::Result result;
+    if (budgetExceeded) {
+      LLVM_DEBUG(dbgs() << "Budget exceeded, skipping function: " << h.F->getName() << "\n");
+      result = ProgramComplexity::makeSkippedFunction(*h.F);
+    }
+    else {
+      result = FAM.getResult<ProgramComplexity>(*h.F);
+      analyzedFunctions++;
+    }
+
+    json::OStream JOS(OS, /*PrettyPrint*/ 1);
+    JOS.value(std::move(result->makeJson()));
+    OS << '\n';
+
+    // Function is not visited again, free its analyses to bound memory use
+    FAM.clear(*h.F, h.F->getName());
+  }
+
+  return PreservedAnalyses::all();
+}
+
 extern "C" ::llvm::PassPluginLibraryInfo LLVM_ATTRIBUTE_WEAK
 llvmGetPassPluginInfo() {
   return {LLVM_PLUGIN_API_VERSION, "ProgramComplexityPrinterPass", "v0.1",
@@ -45,6 +189,19 @@ llvmGetPassPluginInfo() {
                   }
                   return false;
                 });
+            PB.registerPipelineParsingCallback(
+                [](StringRef Name, ModulePassManager &MPM,
+                   ArrayRef<PassBuilder::PipelineElement>) {
+                  if (Name == "print-program-complexity-lines") {
+                    MPM.addPass(ProgramComplexityLinesPrinterPass(dbgs()));
+                    return true;
+                  }
+                  if (Name == "print-program-complexity-budgeted") {
+                    MPM.addPass(ProgramComplexityBudgetedPrinterPass(dbgs()));
+                    return true;
+                  }
+                  return false;
+                });
             // Register required ProgramComplexity analysis pass
             PB.registerAnalysisRegistrationCallback(
                 [](FunctionAnalysisManager &FAM) {
@@ -0,0 +1,18 @@
+#include <omp.h>
+
+typedef int (*op_t)(int);
+
+int add_one(int x) { return x + 1; }
+
+int twice(int x) { return 2 * x; }
+
+int apply(op_t op, int x) {
+    return op(x);                   // indirect call, profiled targets
+}
+
+void run_parallel(int *data, op_t op) {
+    #pragma omp parallel num_threads(4)
+    {
+        data[omp_get_thread_num()] = op(1);     // indirect call, unknown target
+    }
+}
@@ -0,0 +1,159 @@
+; ModuleID = 'calls.c'
+source_filename = "calls.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+%struct.ident_t = type { i32, i32, i32, i32, ptr }
+
+@0 = private unnamed_addr constant [23 x i8] c";unknown;unknown;0;0;;\00", align 1
+@1 = private unnamed_addr constant %struct.ident_t { i32 0, i32 2, i32 0, i32 22, ptr @0 }, align 8
+
+; Function Attrs: mustprogress nofree norecurse nosync nounwind willreturn memory(none) uwtable
+define dso_local i32 @add_one(i32 noundef %x) local_unnamed_addr #0 !dbg !13 {
+entry:
+  tail call void @llvm.dbg.value(metadata i32 %x, metadata !18, metadata !DIExpression()), !dbg !19
+  %add = add nsw i32 %x, 1, !dbg !20
+  ret i32 %add, !dbg !21
+}
+
+; Function Attrs: mustprogress nofree norecurse nosync nounwind willreturn memory(none) uwtable
+define dso_local i32 @twice(i32 noundef %x) local_unnamed_addr #0 !dbg !22 {
+entry:
+  tail call void @llvm.dbg.value(metadata i32 %x, metadata !24, metadata !DIExpression()), !dbg !25
+  %mul = shl nsw i32 %x, 1, !dbg !26
+  ret i32 %mul, !dbg !27
+}
+
+; Function Attrs: nounwind uwtable
+define dso_local i32 @apply(ptr nocapture noundef readonly %op, i32 noundef %x) local_unnamed_addr #1 !dbg !28 {
+entry:
+  tail call void @llvm.dbg.value(metadata ptr %op, metadata !33, metadata !DIExpression()), !dbg !35
+  tail call void @llvm.dbg.value(metadata i32 %x, metadata !34, metadata !DIExpression()), !dbg !35
+  %call = tail call i32 %op(i32 noundef %x) #4, !dbg !36, !prof !37
+  ret i32 %call, !dbg !38
+}
+
+; Function Attrs: nounwind uwtable
+define dso_local void @run_parallel(ptr noundef %data, ptr noundef %op) local_unnamed_addr #1 !dbg !39 {
+entry:
+  %data.addr = alloca ptr, align 8
+  %op.addr = alloca ptr, align 8
+  tail call void @llvm.dbg.value(metadata ptr %data, metadata !44, metadata !DIExpression()), !dbg !46
+  tail call void @llvm.dbg.value(metadata ptr %op, metadata !45, metadata !DIExpression()), !dbg !46
+  %0 = tail call i32 @__kmpc_global_thread_num(ptr nonnull @1), !dbg !47
+  store ptr %data, ptr %data.addr, align 8, !tbaa !48
+  store ptr %op, ptr %op.addr, align 8, !tbaa !48
+  call void @__kmpc_push_num_threads(ptr nonnull @1, i32 %0, i32 4), !dbg !47
+  call void (ptr, i32, ptr, ...) @__kmpc_fork_call(ptr nonnull @1, i32 2, ptr nonnull @run_parallel.omp_outlined, ptr nonnull %data.addr, ptr nonnull %op.addr), !dbg !47
+  ret void, !dbg !52
+}
+
+; Function Attrs: nounwind uwtable
+define internal void @run_parallel.omp_outlined(ptr noalias nocapture readnone %.global_tid., ptr noalias nocapture readnone %.bound_tid., ptr nocapture noundef nonnull readonly align 8 dereferenceable(8) %data, ptr nocapture noundef nonnull readonly align 8 dereferenceable(8) %op) #1 !dbg !53 {
+entry:
+  tail call void @llvm.dbg.value(metadata ptr %data, metadata !57, metadata !DIExpression()), !dbg !59
+  tail call void @llvm.dbg.value(metadata ptr %op, metadata !58, metadata !DIExpression()), !dbg !59
+  %0 = load ptr, ptr %op, align 8, !dbg !60, !tbaa !48
+  %call = tail call i32 %0(i32 noundef 1) #4, !dbg !60
+  %1 = load ptr, ptr %data, align 8, !dbg !61, !tbaa !48
+  %call1 = tail call i32 @omp_get_thread_num() #4, !dbg !62
+  %idxprom = sext i32 %call1 to i64, !dbg !61
+  %arrayidx = getelementptr inbounds i32, ptr %1, i64 %idxprom, !dbg !61
+  store i32 %call, ptr %arrayidx, align 4, !dbg !63, !tbaa !64
+  ret void, !dbg !66
+}
+
+declare !dbg !67 i32 @omp_get_thread_num() local_unnamed_addr #2
+
+declare i32 @__kmpc_global_thread_num(ptr) local_unnamed_addr #4
+
+declare void @__kmpc_push_num_threads(ptr, i32, i32) local_unnamed_addr #4
+
+; Function Attrs: nounwind
+declare !callback !70 void @__kmpc_fork_call(ptr, i32, ptr, ...) local_unnamed_addr #4
+
+; Function Attrs: nocallback nofree nosync nounwind speculatable willreturn memory(none)
+declare void @llvm.dbg.value(metadata, metadata, metadata) #3
+
+attributes #0 = { mustprogress nofree norecurse nosync nounwind willreturn memory(none) uwtable "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+attributes #1 = { nounwind uwtable "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+attributes #2 = { "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+attributes #3 = { nocallback nofree nosync nounwind speculatable willreturn memory(none) }
+attributes #4 = { nounwind }
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!2, !3, !4, !5, !6, !7, !8, !9}
+!llvm.ident = !{!10}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C11, file: !1, producer: "clang version 18.0.0git (https://github.com/llvm/llvm-project.git 86bc18ade8f335f03f607142311957129e156efc)", isOptimized: true, runtimeVersion: 0, emissionKind: FullDebug, splitDebugInlining: false, nameTableKind: None)
+!1 = !DIFile(filename: "calls.c", directory: "/home/ubuntu/mgr/tests/calls", checksumkind: CSK_MD5, checksum: "8635e3b4dce7eb08c03fb70c5f493c9d")
+!2 = !{i32 7, !"Dwarf Version", i32 5}
+!3 = !{i32 2, !"Debug Info Version", i32 3}
+!4 = !{i32 1, !"wchar_size", i32 4}
+!5 = !{i32 7, !"openmp", i32 51}
+!6 = !{i32 8, !"PIC Level", i32 2}
+!7 = !{i32 7, !"PIE Level", i32 2}
+!8 = !{i32 7, !"uwtable", i32 2}
+!9 = !{i32 7, !"frame-pointer", i32 2}
+!10 = !{!"clang version 18.0.0git (https://github.com/llvm/llvm-project.git 86bc18ade8f335f03f607142311957129e156efc)"}
+!11 = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+!12 = !{!11, !11}
+!13 = distinct !DISubprogram(name: "add_one", scope: !1, file: !1, line: 6, type: !14, scopeLine: 6, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !17)
+!14 = !DISubroutineType(types: !12)
+!15 = !DIDerivedType(tag: DW_TAG_typedef, name: "op_t", file: !1, line: 3, baseType: !16)
+!16 = !DIDerivedType(tag: DW_TAG_pointer_type, baseType: !14, size: 64)
+!17 = !{!18}
+!18 = !DILocalVariable(name: "x", arg: 1, scope: !13, file: !1, line: 6, type: !11)
+!19 = !DILocation(line: 0, scope: !13)
+!20 = !DILocation(line: 6, column: 31, scope: !13)
+!21 = !DILocation(line: 6, column: 22, scope: !13)
+!22 = distinct !DISubprogram(name: "twice", scope: !1, file: !1, line: 8, type: !14, scopeLine: 8, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !23)
+!23 = !{!24}
+!24 = !DILocalVariable(name: "x", arg: 1, scope: !22, file: !1, line: 8, type: !11)
+!25 = !DILocation(line: 0, scope: !22)
+!26 = !DILocation(line: 8, column: 29, scope: !22)
+!27 = !DILocation(line: 8, column: 20, scope: !22)
+!28 = distinct !DISubprogram(name: "apply", scope: !1, file: !1, line: 10, type: !29, scopeLine: 10, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !32)
+!29 = !DISubroutineType(types: !30)
+!30 = !{!11, !15, !11}
+!31 = !DIDerivedType(tag: DW_TAG_pointer_type, baseType: !11, size: 64)
+!32 = !{!33, !34}
+!33 = !DILocalVariable(name: "op", arg: 1, scope: !28, file: !1, line: 10, type: !15)
+!34 = !DILocalVariable(name: "x", arg: 2, scope: !28, file: !1, line: 10, type: !11)
+!35 = !DILocation(line: 0, scope: !28)
+!36 = !DILocation(line: 11, column: 12, scope: !28)
+!37 = !{!"VP", i32 0, i64 100, i64 -8255047354391705942, i64 90, i64 -4929062420463572052, i64 10}
+!38 = !DILocation(line: 11, column: 5, scope: !28)
+!39 = distinct !DISubprogram(name: "run_parallel", scope: !1, file: !1, line: 13, type: !40, scopeLine: 13, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !43)
+!40 = !DISubroutineType(types: !41)
+!41 = !{null, !31, !15}
+!42 = !DIDerivedType(tag: DW_TAG_restrict_type, baseType: !31)
+!43 = !{!44, !45}
+!44 = !DILocalVariable(name: "data", arg: 1, scope: !39, file: !1, line: 13, type: !31)
+!45 = !DILocalVariable(name: "op", arg: 2, scope: !39, file: !1, line: 13, type: !15)
+!46 = !DILocation(line: 0, scope: !39)
+!47 = !DILocation(line: 14, column: 5, scope: !39)
+!48 = !{!49, !49, i64 0}
+!49 = !{!"any pointer", !50, i64 0}
+!50 = !{!"omnipotent char", !51, i64 0}
+!51 = !{!"Simple C/C++ TBAA"}
+!52 = !DILocation(line: 18, column: 1, scope: !39)
+!53 = distinct !DISubprogram(name: "run_parallel.omp_outlined", scope: !1, file: !1, line: 15, type: !54, scopeLine: 15, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagLocalToUnit | DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !56)
+!54 = !DISubroutineType(types: !55)
+!55 = !{null, !42, !42, !31, !15}
+!56 = !{!57, !58}
+!57 = !DILocalVariable(name: "data", arg: 3, scope: !53, file: !1, line: 13, type: !31)
+!58 = !DILocalVariable(name: "op", arg: 4, scope: !53, file: !1, line: 13, type: !15)
+!59 = !DILocation(line: 0, scope: !53)
+!60 = !DILocation(line: 16, column: 38, scope: !53)
+!61 = !DILocation(line: 16, column: 9, scope: !53)
+!62 = !DILocation(line: 16, column: 14, scope: !53)
+!63 = !DILocation(line: 16, column: 36, scope: !53)
+!64 = !{!65, !65, i64 0}
+!65 = !{!"int", !50, i64 0}
+!66 = !DILocation(line: 17, column: 5, scope: !53)
+!67 = !DISubprogram(name: "omp_get_thread_num", scope: !68, file: !68, line: 71, type: !69, flags: DIFlagPrototyped, spFlags: DISPFlagOptimized)
+!68 = !DIFile(filename: "/usr/lib/llvm-18/lib/clang/18/include/omp.h", directory: "")
+!69 = !DISubroutineType(types: !{!11})
+!70 = !{!71}
+!71 = !{i64 2, i64 -1, i64 -1, i1 true}
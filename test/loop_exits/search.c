@@ -0,0 +1,16 @@
+// Loops with early exit and data dependent trip count
+
+int find(const int *data, int key) {
+    for (int i = 0; i < 100; i++) {
+        if (data[i] == key)
+            return i;
+    }
+    return -1;
+}
+
+int find_until(const int *data, int n, int key) {
+    int i = 0;
+    while (i < n && data[i] != key)
+        i++;
+    return i;
+}
@@ -0,0 +1,140 @@
+; ModuleID = 'search.c'
+source_filename = "search.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+; Function Attrs: nofree norecurse nosync nounwind memory(argmem: read) uwtable
+define dso_local i32 @find(ptr nocapture noundef readonly %data, i32 noundef %key) local_unnamed_addr #0 !dbg !10 {
+entry:
+  tail call void @llvm.dbg.value(metadata ptr %data, metadata !18, metadata !DIExpression()), !dbg !21
+  tail call void @llvm.dbg.value(metadata i32 %key, metadata !19, metadata !DIExpression()), !dbg !21
+  tail call void @llvm.dbg.value(metadata i32 0, metadata !20, metadata !DIExpression()), !dbg !22
+  br label %for.body, !dbg !23
+
+for.body:                                         ; preds = %entry, %for.inc
+  %indvars.iv = phi i64 [ 0, %entry ], [ %indvars.iv.next, %for.inc ]
+  tail call void @llvm.dbg.value(metadata i64 %indvars.iv, metadata !20, metadata !DIExpression()), !dbg !22
+  %arrayidx = getelementptr inbounds i32, ptr %data, i64 %indvars.iv, !dbg !25
+  %0 = load i32, ptr %arrayidx, align 4, !dbg !25, !tbaa !28
+  %cmp1 = icmp eq i32 %0, %key, !dbg !32
+  br i1 %cmp1, label %cleanup.loopexit, label %for.inc, !dbg !33
+
+for.inc:                                          ; preds = %for.body
+  %indvars.iv.next = add nuw nsw i64 %indvars.iv, 1, !dbg !34
+  tail call void @llvm.dbg.value(metadata i64 %indvars.iv.next, metadata !20, metadata !DIExpression()), !dbg !22
+  %exitcond.not = icmp eq i64 %indvars.iv.next, 100, !dbg !35
+  br i1 %exitcond.not, label %cleanup, label %for.body, !dbg !23, !llvm.loop !36
+
+cleanup.loopexit:                                 ; preds = %for.body
+  %1 = trunc i64 %indvars.iv to i32, !dbg !39
+  br label %cleanup, !dbg !40
+
+cleanup:                                          ; preds = %for.inc, %cleanup.loopexit
+  %retval.0 = phi i32 [ %1, %cleanup.loopexit ], [ -1, %for.inc ], !dbg !21
+  ret i32 %retval.0, !dbg !40
+}
+
+; Function Attrs: nofree norecurse nosync nounwind memory(argmem: read) uwtable
+define dso_local i32 @find_until(ptr nocapture noundef readonly %data, i32 noundef %n, i32 noundef %key) local_unnamed_addr #0 !dbg !41 {
+entry:
+  tail call void @llvm.dbg.value(metadata ptr %data, metadata !45, metadata !DIExpression()), !dbg !49
+  tail call void @llvm.dbg.value(metadata i32 %n, metadata !46, metadata !DIExpression()), !dbg !49
+  tail call void @llvm.dbg.value(metadata i32 %key, metadata !47, metadata !DIExpression()), !dbg !49
+  tail call void @llvm.dbg.value(metadata i32 0, metadata !48, metadata !DIExpression()), !dbg !49
+  %cmp9 = icmp sgt i32 %n, 0, !dbg !50
+  br i1 %cmp9, label %land.rhs.preheader, label %while.end, !dbg !51
+
+land.rhs.preheader:                               ; preds = %entry
+  %wide.trip.count = zext i32 %n to i64, !dbg !50
+  br label %land.rhs, !dbg !51
+
+land.rhs:                                         ; preds = %land.rhs.preheader, %while.body
+  %indvars.iv = phi i64 [ 0, %land.rhs.preheader ], [ %indvars.iv.next, %while.body ]
+  tail call void @llvm.dbg.value(metadata i64 %indvars.iv, metadata !48, metadata !DIExpression()), !dbg !49
+  %arrayidx = getelementptr inbounds i32, ptr %data, i64 %indvars.iv, !dbg !52
+  %0 = load i32, ptr %arrayidx, align 4, !dbg !52, !tbaa !28
+  %cmp1.not = icmp eq i32 %0, %key, !dbg !53
+  br i1 %cmp1.not, label %while.end.loopexit.split.loop.exit, label %while.body, !dbg !51
+
+while.body:                                       ; preds = %land.rhs
+  %indvars.iv.next = add nuw nsw i64 %indvars.iv, 1, !dbg !54
+  tail call void @llvm.dbg.value(metadata i64 %indvars.iv.next, metadata !48, metadata !DIExpression()), !dbg !49
+  %exitcond.not = icmp eq i64 %indvars.iv.next, %wide.trip.count, !dbg !50
+  br i1 %exitcond.not, label %while.end, label %land.rhs, !dbg !51, !llvm.loop !55
+
+while.end.loopexit.split.loop.exit:               ; preds = %land.rhs
+  %1 = trunc i64 %indvars.iv to i32, !dbg !49
+  br label %while.end, !dbg !57
+
+while.end:                                        ; preds = %while.body, %while.end.loopexit.split.loop.exit, %entry
+  %i.0.lcssa = phi i32 [ 0, %entry ], [ %1, %while.end.loopexit.split.loop.exit ], [ %n, %while.body ], !dbg !49
+  ret i32 %i.0.lcssa, !dbg !57
+}
+
+; Function Attrs: nocallback nofree nosync nounwind speculatable willreturn memory(none)
+declare void @llvm.dbg.value(metadata, metadata, metadata) #1
+
+attributes #0 = { nofree norecurse nosync nounwind memory(argmem: read) uwtable "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+attributes #1 = { nocallback nofree nosync nounwind speculatable willreturn memory(none) }
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!2, !3, !4, !5, !6, !7}
+!llvm.ident = !{!8}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C11, file: !1, producer: "clang version 18.0.0git (https://github.com/llvm/llvm-project.git 86bc18ade8f335f03f607142311957129e156efc)", isOptimized: true, runtimeVersion: 0, emissionKind: FullDebug, splitDebugInlining: false, nameTableKind: None)
+!1 = !DIFile(filename: "search.c", directory: "/home/ubuntu/mgr/tests/loop_exits", checksumkind: CSK_MD5, checksum: "e799321750b0fc2f04ce08b2692ea1e7")
+!2 = !{i32 7, !"Dwarf Version", i32 5}
+!3 = !{i32 2, !"Debug Info Version", i32 3}
+!4 = !{i32 1, !"wchar_size", i32 4}
+!5 = !{i32 8, !"PIC Level", i32 2}
+!6 = !{i32 7, !"PIE Level", i32 2}
+!7 = !{i32 7, !"uwtable", i32 2}
+!8 = !{!"clang version 18.0.0git (https://github.com/llvm/llvm-project.git 86bc18ade8f335f03f607142311957129e156efc)"}
+!9 = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+!10 = distinct !DISubprogram(name: "find", scope: !1, file: !1, line: 3, type: !11, scopeLine: 3, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !17)
+!11 = !DISubroutineType(types: !12)
+!12 = !{!9, !13, !9}
+!13 = !DIDerivedType(tag: DW_TAG_pointer_type, baseType: !14, size: 64)
+!14 = !DIDerivedType(tag: DW_TAG_const_type, baseType: !9)
+!15 = distinct !DILexicalBlock(scope: !10, file: !1, line: 4, column: 5)
+!16 = distinct !DILexicalBlock(scope: !15, file: !1, line: 4, column: 5)
+!17 = !{!18, !19, !20}
+!18 = !DILocalVariable(name: "data", arg: 1, scope: !10, file: !1, line: 3, type: !13)
+!19 = !DILocalVariable(name: "key", arg: 2, scope: !10, file: !1, line: 3, type: !9)
+!20 = !DILocalVariable(name: "i", scope: !15, file: !1, line: 4, type: !9)
+!21 = !DILocation(line: 0, scope: !10)
+!22 = !DILocation(line: 0, scope: !15)
+!23 = !DILocation(line: 4, column: 5, scope: !15)
+!24 = distinct !DILexicalBlock(scope: !16, file: !1, line: 4, column: 35)
+!25 = !DILocation(line: 5, column: 13, scope: !26)
+!26 = distinct !DILexicalBlock(scope: !24, file: !1, line: 5, column: 13)
+!28 = !{!29, !29, i64 0}
+!29 = !{!"int", !30, i64 0}
+!30 = !{!"omnipotent char", !31, i64 0}
+!31 = !{!"Simple C/C++ TBAA"}
+!32 = !DILocation(line: 5, column: 21, scope: !26)
+!33 = !DILocation(line: 5, column: 13, scope: !24)
+!34 = !DILocation(line: 4, column: 31, scope: !16)
+!35 = !DILocation(line: 4, column: 23, scope: !16)
+!36 = distinct !{!36, !23, !37, !38}
+!37 = !DILocation(line: 7, column: 5, scope: !15)
+!38 = !{!"llvm.loop.mustprogress"}
+!39 = !DILocation(line: 6, column: 20, scope: !26)
+!40 = !DILocation(line: 9, column: 1, scope: !10)
+!41 = distinct !DISubprogram(name: "find_until", scope: !1, file: !1, line: 11, type: !42, scopeLine: 11, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !44)
+!42 = !DISubroutineType(types: !43)
+!43 = !{!9, !13, !9, !9}
+!44 = !{!45, !46, !47, !48}
+!45 = !DILocalVariable(name: "data", arg: 1, scope: !41, file: !1, line: 11, type: !13)
+!46 = !DILocalVariable(name: "n", arg: 2, scope: !41, file: !1, line: 11, type: !9)
+!47 = !DILocalVariable(name: "key", arg: 3, scope: !41, file: !1, line: 11, type: !9)
+!48 = !DILocalVariable(name: "i", scope: !41, file: !1, line: 12, type: !9)
+!49 = !DILocation(line: 0, scope: !41)
+!50 = !DILocation(line: 13, column: 14, scope: !41)
+!51 = !DILocation(line: 13, column: 5, scope: !41)
+!52 = !DILocation(line: 13, column: 21, scope: !41)
+!53 = !DILocation(line: 13, column: 29, scope: !41)
+!54 = !DILocation(line: 14, column: 10, scope: !41)
+!55 = distinct !{!55, !51, !56, !38}
+!56 = !DILocation(line: 14, column: 11, scope: !41)
+!57 = !DILocation(line: 15, column: 5, scope: !41)
@@ -0,0 +1,28 @@
+// Loops touching memory with different access patterns
+
+void scale(int *a, const int *s, long n) {
+    for (long i = 0; i < n; i++)
+        a[i] = a[i] * *s;               // unit-stride a[i], invariant *s
+}
+
+int gather(const int *a, const int *idx, long n) {
+    int sum = 0;
+    for (long i = 0; i < n; i++)
+        sum += a[idx[i]];               // unit-stride idx[i], indirect a[idx[i]]
+    return sum;
+}
+
+long strided(const long *a, long step, long n) {
+    long sum = 0;
+    for (long i = 0; i < n; i++)
+        sum += a[2 * i] + a[i * step];  // constant-stride, invariant-stride
+    return sum;
+}
+
+int matrix_sum(const int *m, long rows) {
+    int sum = 0;
+    for (long i = 0; i < rows; i++)
+        for (long j = 0; j < 64; j++)
+            sum += m[i * 64 + j];       // inner loop footprint touched in every outer iteration
+    return sum;
+}
@@ -0,0 +1,273 @@
+; ModuleID = 'memory.c'
+source_filename = "memory.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+; Function Attrs: nofree norecurse nosync nounwind memory(argmem: readwrite) uwtable
+define dso_local void @scale(ptr nocapture noundef %a, ptr nocapture noundef readonly %s, i64 noundef %n) local_unnamed_addr #0 !dbg !11 {
+entry:
+  tail call void @llvm.dbg.value(metadata ptr %a, metadata !18, metadata !DIExpression()), !dbg !23
+  tail call void @llvm.dbg.value(metadata ptr %s, metadata !19, metadata !DIExpression()), !dbg !23
+  tail call void @llvm.dbg.value(metadata i64 %n, metadata !20, metadata !DIExpression()), !dbg !23
+  tail call void @llvm.dbg.value(metadata i64 0, metadata !21, metadata !DIExpression()), !dbg !24
+  %cmp7 = icmp sgt i64 %n, 0, !dbg !25
+  br i1 %cmp7, label %for.body, label %for.cond.cleanup, !dbg !26
+
+for.cond.cleanup:                                 ; preds = %for.body, %entry
+  ret void, !dbg !27
+
+for.body:                                         ; preds = %entry, %for.body
+  %i.08 = phi i64 [ %inc, %for.body ], [ 0, %entry ]
+  tail call void @llvm.dbg.value(metadata i64 %i.08, metadata !21, metadata !DIExpression()), !dbg !24
+  %arrayidx = getelementptr inbounds i32, ptr %a, i64 %i.08, !dbg !28
+  %0 = load i32, ptr %arrayidx, align 4, !dbg !28, !tbaa !29
+  %1 = load i32, ptr %s, align 4, !dbg !33, !tbaa !29
+  %mul = mul nsw i32 %1, %0, !dbg !34
+  store i32 %mul, ptr %arrayidx, align 4, !dbg !35, !tbaa !29
+  %inc = add nuw nsw i64 %i.08, 1, !dbg !36
+  tail call void @llvm.dbg.value(metadata i64 %inc, metadata !21, metadata !DIExpression()), !dbg !24
+  %exitcond.not = icmp eq i64 %inc, %n, !dbg !25
+  br i1 %exitcond.not, label %for.cond.cleanup, label %for.body, !dbg !26, !llvm.loop !37
+}
+
+; Function Attrs: nofree norecurse nosync nounwind memory(argmem: read) uwtable
+define dso_local i32 @gather(ptr nocapture noundef readonly %a, ptr nocapture noundef readonly %idx, i64 noundef %n) local_unnamed_addr #1 !dbg !40 {
+entry:
+  tail call void @llvm.dbg.value(metadata ptr %a, metadata !44, metadata !DIExpression()), !dbg !50
+  tail call void @llvm.dbg.value(metadata ptr %idx, metadata !45, metadata !DIExpression()), !dbg !50
+  tail call void @llvm.dbg.value(metadata i64 %n, metadata !46, metadata !DIExpression()), !dbg !50
+  tail call void @llvm.dbg.value(metadata i32 0, metadata !47, metadata !DIExpression()), !dbg !50
+  tail call void @llvm.dbg.value(metadata i64 0, metadata !48, metadata !DIExpression()), !dbg !51
+  %cmp8 = icmp sgt i64 %n, 0, !dbg !52
+  br i1 %cmp8, label %for.body, label %for.cond.cleanup, !dbg !53
+
+for.cond.cleanup:                                 ; preds = %for.body, %entry
+  %sum.0.lcssa = phi i32 [ 0, %entry ], [ %add, %for.body ], !dbg !50
+  ret i32 %sum.0.lcssa, !dbg !54
+
+for.body:                                         ; preds = %entry, %for.body
+  %i.010 = phi i64 [ %inc, %for.body ], [ 0, %entry ]
+  %sum.09 = phi i32 [ %add, %for.body ], [ 0, %entry ]
+  tail call void @llvm.dbg.value(metadata i64 %i.010, metadata !48, metadata !DIExpression()), !dbg !51
+  tail call void @llvm.dbg.value(metadata i32 %sum.09, metadata !47, metadata !DIExpression()), !dbg !50
+  %arrayidx = getelementptr inbounds i32, ptr %idx, i64 %i.010, !dbg !55
+  %0 = load i32, ptr %arrayidx, align 4, !dbg !55, !tbaa !29
+  %idxprom = sext i32 %0 to i64, !dbg !56
+  %arrayidx1 = getelementptr inbounds i32, ptr %a, i64 %idxprom, !dbg !56
+  %1 = load i32, ptr %arrayidx1, align 4, !dbg !56, !tbaa !29
+  %add = add nsw i32 %1, %sum.09, !dbg !57
+  tail call void @llvm.dbg.value(metadata i32 %add, metadata !47, metadata !DIExpression()), !dbg !50
+  %inc = add nuw nsw i64 %i.010, 1, !dbg !58
+  tail call void @llvm.dbg.value(metadata i64 %inc, metadata !48, metadata !DIExpression()), !dbg !51
+  %exitcond.not = icmp eq i64 %inc, %n, !dbg !52
+  br i1 %exitcond.not, label %for.cond.cleanup, label %for.body, !dbg !53, !llvm.loop !59
+}
+
+; Function Attrs: nofree norecurse nosync nounwind memory(argmem: read) uwtable
+define dso_local i64 @strided(ptr nocapture noundef readonly %a, i64 noundef %step, i64 noundef %n) local_unnamed_addr #1 !dbg !61 {
+entry:
+  tail call void @llvm.dbg.value(metadata ptr %a, metadata !66, metadata !DIExpression()), !dbg !72
+  tail call void @llvm.dbg.value(metadata i64 %step, metadata !67, metadata !DIExpression()), !dbg !72
+  tail call void @llvm.dbg.value(metadata i64 %n, metadata !68, metadata !DIExpression()), !dbg !72
+  tail call void @llvm.dbg.value(metadata i64 0, metadata !69, metadata !DIExpression()), !dbg !72
+  tail call void @llvm.dbg.value(metadata i64 0, metadata !70, metadata !DIExpression()), !dbg !73
+  %cmp12 = icmp sgt i64 %n, 0, !dbg !74
+  br i1 %cmp12, label %for.body, label %for.cond.cleanup, !dbg !75
+
+for.cond.cleanup:                                 ; preds = %for.body, %entry
+  %sum.0.lcssa = phi i64 [ 0, %entry ], [ %add3, %for.body ], !dbg !72
+  ret i64 %sum.0.lcssa, !dbg !76
+
+for.body:                                         ; preds = %entry, %for.body
+  %i.014 = phi i64 [ %inc, %for.body ], [ 0, %entry ]
+  %sum.013 = phi i64 [ %add3, %for.body ], [ 0, %entry ]
+  tail call void @llvm.dbg.value(metadata i64 %i.014, metadata !70, metadata !DIExpression()), !dbg !73
+  tail call void @llvm.dbg.value(metadata i64 %sum.013, metadata !69, metadata !DIExpression()), !dbg !72
+  %mul = shl nuw nsw i64 %i.014, 1, !dbg !77
+  %arrayidx = getelementptr inbounds i64, ptr %a, i64 %mul, !dbg !78
+  %0 = load i64, ptr %arrayidx, align 8, !dbg !78, !tbaa !79
+  %mul1 = mul nsw i64 %i.014, %step, !dbg !81
+  %arrayidx2 = getelementptr inbounds i64, ptr %a, i64 %mul1, !dbg !82
+  %1 = load i64, ptr %arrayidx2, align 8, !dbg !82, !tbaa !79
+  %add = add i64 %0, %sum.013, !dbg !83
+  %add3 = add i64 %add, %1, !dbg !84
+  tail call void @llvm.dbg.value(metadata i64 %add3, metadata !69, metadata !DIExpression()), !dbg !72
+  %inc = add nuw nsw i64 %i.014, 1, !dbg !85
+  tail call void @llvm.dbg.value(metadata i64 %inc, metadata !70, metadata !DIExpression()), !dbg !73
+  %exitcond.not = icmp eq i64 %inc, %n, !dbg !74
+  br i1 %exitcond.not, label %for.cond.cleanup, label %for.body, !dbg !75, !llvm.loop !86
+}
+
+; Function Attrs: nofree norecurse nosync nounwind memory(argmem: read) uwtable
+define dso_local i32 @matrix_sum(ptr nocapture noundef readonly %m, i64 noundef %rows) local_unnamed_addr #1 !dbg !88 {
+entry:
+  tail call void @llvm.dbg.value(metadata ptr %m, metadata !92, metadata !DIExpression()), !dbg !100
+  tail call void @llvm.dbg.value(metadata i64 %rows, metadata !93, metadata !DIExpression()), !dbg !100
+  tail call void @llvm.dbg.value(metadata i32 0, metadata !94, metadata !DIExpression()), !dbg !100
+  tail call void @llvm.dbg.value(metadata i64 0, metadata !95, metadata !DIExpression()), !dbg !101
+  %cmp18 = icmp sgt i64 %rows, 0, !dbg !102
+  br i1 %cmp18, label %for.cond1.preheader, label %for.cond.cleanup, !dbg !103
+
+for.cond1.preheader:                              ; preds = %entry, %for.cond.cleanup3
+  %i.020 = phi i64 [ %inc7, %for.cond.cleanup3 ], [ 0, %entry ]
+  %sum.019 = phi i32 [ %add5, %for.cond.cleanup3 ], [ 0, %entry ]
+  tail call void @llvm.dbg.value(metadata i64 %i.020, metadata !95, metadata !DIExpression()), !dbg !101
+  tail call void @llvm.dbg.value(metadata i32 %sum.019, metadata !94, metadata !DIExpression()), !dbg !100
+  tail call void @llvm.dbg.value(metadata i64 0, metadata !97, metadata !DIExpression()), !dbg !104
+  %mul = shl nsw i64 %i.020, 6, !dbg !116
+  br label %for.body4, !dbg !105
+
+for.cond.cleanup:                                 ; preds = %for.cond.cleanup3, %entry
+  %sum.0.lcssa = phi i32 [ 0, %entry ], [ %add5, %for.cond.cleanup3 ], !dbg !100
+  ret i32 %sum.0.lcssa, !dbg !106
+
+for.cond.cleanup3:                                ; preds = %for.body4
+  %inc7 = add nuw nsw i64 %i.020, 1, !dbg !107
+  tail call void @llvm.dbg.value(metadata i64 %inc7, metadata !95, metadata !DIExpression()), !dbg !101
+  %exitcond21.not = icmp eq i64 %inc7, %rows, !dbg !102
+  br i1 %exitcond21.not, label %for.cond.cleanup, label %for.cond1.preheader, !dbg !103, !llvm.loop !108
+
+for.body4:                                        ; preds = %for.cond1.preheader, %for.body4
+  %j.017 = phi i64 [ 0, %for.cond1.preheader ], [ %inc, %for.body4 ]
+  %sum.116 = phi i32 [ %sum.019, %for.cond1.preheader ], [ %add5, %for.body4 ]
+  tail call void @llvm.dbg.value(metadata i64 %j.017, metadata !97, metadata !DIExpression()), !dbg !104
+  tail call void @llvm.dbg.value(metadata i32 %sum.116, metadata !94, metadata !DIExpression()), !dbg !100
+  %add = add nuw nsw i64 %j.017, %mul, !dbg !110
+  %arrayidx = getelementptr inbounds i32, ptr %m, i64 %add, !dbg !111
+  %0 = load i32, ptr %arrayidx, align 4, !dbg !111, !tbaa !29
+  %add5 = add nsw i32 %0, %sum.116, !dbg !112
+  tail call void @llvm.dbg.value(metadata i32 %add5, metadata !94, metadata !DIExpression()), !dbg !100
+  %inc = add nuw nsw i64 %j.017, 1, !dbg !113
+  tail call void @llvm.dbg.value(metadata i64 %inc, metadata !97, metadata !DIExpression()), !dbg !104
+  %exitcond.not = icmp eq i64 %inc, 64, !dbg !114
+  br i1 %exitcond.not, label %for.cond.cleanup3, label %for.body4, !dbg !105, !llvm.loop !115
+}
+
+; Function Attrs: nocallback nofree nosync nounwind speculatable willreturn memory(none)
+declare void @llvm.dbg.value(metadata, metadata, metadata) #2
+
+attributes #0 = { nofree norecurse nosync nounwind memory(argmem: readwrite) uwtable "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+attributes #1 = { nofree norecurse nosync nounwind memory(argmem: read) uwtable "min-legal-vector-width"="0" "no-trapping-math"="true" "stack-protector-buffer-size"="8" "target-cpu"="x86-64" "target-features"="+cmov,+cx8,+fxsr,+mmx,+sse,+sse2,+x87" "tune-cpu"="generic" }
+attributes #2 = { nocallback nofree nosync nounwind speculatable willreturn memory(none) }
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!2, !3, !4, !5, !6, !7}
+!llvm.ident = !{!8}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C11, file: !1, producer: "clang version 18.0.0git (https://github.com/llvm/llvm-project.git 86bc18ade8f335f03f607142311957129e156efc)", isOptimized: true, runtimeVersion: 0, emissionKind: FullDebug, splitDebugInlining: false, nameTableKind: None)
+!1 = !DIFile(filename: "memory.c", directory: "/home/ubuntu/mgr/tests/memory", checksumkind: CSK_MD5, checksum: "49b151df9a2d30e74b8599f451c70d4e")
+!2 = !{i32 7, !"Dwarf Version", i32 5}
+!3 = !{i32 2, !"Debug Info Version", i32 3}
+!4 = !{i32 1, !"wchar_size", i32 4}
+!5 = !{i32 8, !"PIC Level", i32 2}
+!6 = !{i32 7, !"PIE Level", i32 2}
+!7 = !{i32 7, !"uwtable", i32 2}
+!8 = !{!"clang version 18.0.0git (https://github.com/llvm/llvm-project.git 86bc18ade8f335f03f607142311957129e156efc)"}
+!9 = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+!10 = !DIBasicType(name: "long", size: 64, encoding: DW_ATE_signed)
+!11 = distinct !DISubprogram(name: "scale", scope: !1, file: !1, line: 3, type: !12, scopeLine: 3, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !17)
+!12 = !DISubroutineType(types: !13)
+!13 = !{null, !14, !15, !10}
+!14 = !DIDerivedType(tag: DW_TAG_pointer_type, baseType: !9, size: 64)
+!15 = !DIDerivedType(tag: DW_TAG_pointer_type, baseType: !16, size: 64)
+!16 = !DIDerivedType(tag: DW_TAG_const_type, baseType: !9)
+!17 = !{!18, !19, !20, !21}
+!18 = !DILocalVariable(name: "a", arg: 1, scope: !11, file: !1, line: 3, type: !14)
+!19 = !DILocalVariable(name: "s", arg: 2, scope: !11, file: !1, line: 3, type: !15)
+!20 = !DILocalVariable(name: "n", arg: 3, scope: !11, file: !1, line: 3, type: !10)
+!21 = !DILocalVariable(name: "i", scope: !22, file: !1, line: 4, type: !10)
+!22 = distinct !DILexicalBlock(scope: !11, file: !1, line: 4, column: 5)
+!23 = !DILocation(line: 0, scope: !11)
+!24 = !DILocation(line: 0, scope: !22)
+!25 = !DILocation(line: 4, column: 24, scope: !22)
+!26 = !DILocation(line: 4, column: 5, scope: !22)
+!27 = !DILocation(line: 6, column: 1, scope: !11)
+!28 = !DILocation(line: 5, column: 16, scope: !22)
+!29 = !{!30, !30, i64 0}
+!30 = !{!"int", !31, i64 0}
+!31 = !{!"omnipotent char", !32, i64 0}
+!32 = !{!"Simple C/C++ TBAA"}
+!33 = !DILocation(line: 5, column: 23, scope: !22)
+!34 = !DILocation(line: 5, column: 21, scope: !22)
+!35 = !DILocation(line: 5, column: 14, scope: !22)
+!36 = !DILocation(line: 4, column: 30, scope: !22)
+!37 = distinct !{!37, !26, !38, !39}
+!38 = !DILocation(line: 5, column: 24, scope: !22)
+!39 = !{!"llvm.loop.mustprogress"}
+!40 = distinct !DISubprogram(name: "gather", scope: !1, file: !1, line: 8, type: !41, scopeLine: 8, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !43)
+!41 = !DISubroutineType(types: !42)
+!42 = !{!9, !15, !15, !10}
+!43 = !{!44, !45, !46, !47, !48}
+!44 = !DILocalVariable(name: "a", arg: 1, scope: !40, file: !1, line: 8, type: !15)
+!45 = !DILocalVariable(name: "idx", arg: 2, scope: !40, file: !1, line: 8, type: !15)
+!46 = !DILocalVariable(name: "n", arg: 3, scope: !40, file: !1, line: 8, type: !10)
+!47 = !DILocalVariable(name: "sum", scope: !40, file: !1, line: 9, type: !9)
+!48 = !DILocalVariable(name: "i", scope: !49, file: !1, line: 10, type: !10)
+!49 = distinct !DILexicalBlock(scope: !40, file: !1, line: 10, column: 5)
+!50 = !DILocation(line: 0, scope: !40)
+!51 = !DILocation(line: 0, scope: !49)
+!52 = !DILocation(line: 10, column: 24, scope: !49)
+!53 = !DILocation(line: 10, column: 5, scope: !49)
+!54 = !DILocation(line: 12, column: 5, scope: !40)
+!55 = !DILocation(line: 11, column: 18, scope: !49)
+!56 = !DILocation(line: 11, column: 16, scope: !49)
+!57 = !DILocation(line: 11, column: 13, scope: !49)
+!58 = !DILocation(line: 10, column: 30, scope: !49)
+!59 = distinct !{!59, !53, !60, !39}
+!60 = !DILocation(line: 11, column: 24, scope: !49)
+!61 = distinct !DISubprogram(name: "strided", scope: !1, file: !1, line: 15, type: !62, scopeLine: 15, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !65)
+!62 = !DISubroutineType(types: !63)
+!63 = !{!10, !64, !10, !10}
+!64 = !DIDerivedType(tag: DW_TAG_pointer_type, baseType: !71, size: 64)
+!65 = !{!66, !67, !68, !69, !70}
+!66 = !DILocalVariable(name: "a", arg: 1, scope: !61, file: !1, line: 15, type: !64)
+!67 = !DILocalVariable(name: "step", arg: 2, scope: !61, file: !1, line: 15, type: !10)
+!68 = !DILocalVariable(name: "n", arg: 3, scope: !61, file: !1, line: 15, type: !10)
+!69 = !DILocalVariable(name: "sum", scope: !61, file: !1, line: 16, type: !10)
+!70 = !DILocalVariable(name: "i", scope: !87, file: !1, line: 17, type: !10)
+!71 = !DIDerivedType(tag: DW_TAG_const_type, baseType: !10)
+!72 = !DILocation(line: 0, scope: !61)
+!73 = !DILocation(line: 0, scope: !87)
+!74 = !DILocation(line: 17, column: 24, scope: !87)
+!75 = !DILocation(line: 17, column: 5, scope: !87)
+!76 = !DILocation(line: 19, column: 5, scope: !61)
+!77 = !DILocation(line: 18, column: 20, scope: !87)
+!78 = !DILocation(line: 18, column: 16, scope: !87)
+!79 = !{!80, !80, i64 0}
+!80 = !{!"long", !31, i64 0}
+!81 = !DILocation(line: 18, column: 31, scope: !87)
+!82 = !DILocation(line: 18, column: 27, scope: !87)
+!83 = !DILocation(line: 18, column: 25, scope: !87)
+!84 = !DILocation(line: 18, column: 13, scope: !87)
+!85 = !DILocation(line: 17, column: 30, scope: !87)
+!86 = distinct !{!86, !75, !84, !39}
+!87 = distinct !DILexicalBlock(scope: !61, file: !1, line: 17, column: 5)
+!88 = distinct !DISubprogram(name: "matrix_sum", scope: !1, file: !1, line: 22, type: !89, scopeLine: 22, flags: DIFlagPrototyped | DIFlagAllCallsDescribed, spFlags: DISPFlagDefinition | DISPFlagOptimized, unit: !0, retainedNodes: !91)
+!89 = !DISubroutineType(types: !90)
+!90 = !{!9, !15, !10}
+!91 = !{!92, !93, !94, !95, !97}
+!92 = !DILocalVariable(name: "m", arg: 1, scope: !88, file: !1, line: 22, type: !15)
+!93 = !DILocalVariable(name: "rows", arg: 2, scope: !88, file: !1, line: 22, type: !10)
+!94 = !DILocalVariable(name: "sum", scope: !88, file: !1, line: 23, type: !9)
+!95 = !DILocalVariable(name: "i", scope: !96, file: !1, line: 24, type: !10)
+!96 = distinct !DILexicalBlock(scope: !88, file: !1, line: 24, column: 5)
+!97 = !DILocalVariable(name: "j", scope: !98, file: !1, line: 25, type: !10)
+!98 = distinct !DILexicalBlock(scope: !99, file: !1, line: 25, column: 9)
+!99 = distinct !DILexicalBlock(scope: !96, file: !1, line: 24, column: 5)
+!100 = !DILocation(line: 0, scope: !88)
+!101 = !DILocation(line: 0, scope: !96)
+!102 = !DILocation(line: 24, column: 24, scope: !96)
+!103 = !DILocation(line: 24, column: 5, scope: !96)
+!104 = !DILocation(line: 0, scope: !98)
+!105 = !DILocation(line: 25, column: 9, scope: !98)
+!106 = !DILocation(line: 27, column: 5, scope: !88)
+!107 = !DILocation(line: 24, column: 33, scope: !99)
+!108 = distinct !{!108, !103, !109, !39}
+!109 = !DILocation(line: 26, column: 32, scope: !96)
+!110 = !DILocation(line: 26, column: 29, scope: !98)
+!111 = !DILocation(line: 26, column: 20, scope: !98)
+!112 = !DILocation(line: 26, column: 17, scope: !98)
+!113 = !DILocation(line: 25, column: 35, scope: !98)
+!114 = !DILocation(line: 25, column: 28, scope: !98)
+!115 = distinct !{!115, !105, !109, !39}
+!116 = !DILocation(line: 26, column: 24, scope: !98)
@@ -0,0 +1,638 @@
+// Long running ProgramComplexity analysis daemon.
+//
+// Daemon listens on a Unix domain socket and answers with ProgramComplexity
+// models of IR modules (bitcode or textual IR) sent by clients. Process,
+// option parsing and per worker pass builder stay resident between requests,
+// and responses are cached by module content, so repeated requests for the
+// same module are answered without running analysis again. Acceptor thread
+// polls idle connections and queues each received request to one of worker
+// threads, so clients keeping connection open don't hold workers. Analysis
+// runs in a fresh LLVMContext for every request, as analysis results are tied
+// to request module. Functions not meeting debug info requirements of analysis
+// are printed marked as skipped.
+//
+// Protocol, all integers are native endian:
+//   request:  u8 kind, u64 payload size, payload
+//   response: u8 status, u64 payload size, payload
+// Request kinds:
+//   'J' - payload is module, answer with pretty printed json, same as
+//         print-program-complexity pass prints
+//   'j' - payload is module, answer with compact json, one function per line
+//   'S' - empty payload, answer with request latency statistics json
+// Response status is 'O' on success, 'E' on error with message as payload.
+// Connection can be used for any number of requests. Request bigger than
+// -max-request-size is answered with error and connection is closed.
+//
+// Same binary is also a client: -request=<file> sends module and prints
+// response, -latency-stats prints daemon statistics.
+
+#include "ProgramComplexity.h"
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <csignal>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace llvm;
+
+static cl::opt<std::string> SocketPath(
+    "socket", cl::init("/tmp/program-complexity.sock"),
+    cl::desc("Path of Unix domain socket daemon listens on."));
+
+static cl::opt<unsigned> Workers(
+    "workers", cl::init(0),
+    cl::desc("Number of worker threads, 0 uses all cores."));
+
+static cl::opt<unsigned> CacheSize(
+    "cache-size", cl::init(64),
+    cl::desc("Number of responses cached by module content, 0 disables "
+             "cache."));
+
+static cl::opt<uint64_t> MaxRequestSize(
+    "max-request-size", cl::init(uint64_t(1) << 30),
+    cl::desc("Largest accepted request payload in bytes, bigger requests are "
+             "answered with error."));
+
+static cl::opt<unsigned> IOTimeout(
+    "io-timeout", cl::init(30),
+    cl::desc("Seconds in which whole request has to be received, and whole "
+             "response sent, once it started, otherwise connection is "
+             "closed. 0 waits forever."));
+
+static cl::opt<std::string> RequestFile(
+    "request", cl::init(""),
+    cl::desc("Client mode: send module from given file to daemon and print "
+             "response."));
+
+static cl::opt<bool> CompactJson(
+    "compact", cl::init(false),
+    cl::desc("Client mode: request compact json, one function per line."));
+
+static cl::opt<bool> Stats(
+    "latency-stats", cl::init(false),
+    cl::desc("Client mode: print daemon request latency statistics."));
+
+namespace {
+
+const char RequestPrettyJson = 'J';
+const char RequestCompactJson = 'j';
+const char RequestStats = 'S';
+const char ResponseOk = 'O';
+const char ResponseError = 'E';
+
+// Number of latest request latencies kept for percentiles
+const size_t LatencyWindow = 10000;
+
+// Payload buffer grows by received data, not by size declared in header
+const size_t PayloadChunkSize = 1 << 16;
+
+typedef std::chrono::steady_clock Clock;
+const Clock::time_point NoDeadline = Clock::time_point::max();
+
+Clock::time_point ioDeadline() {
+  return IOTimeout ? Clock::now() + std::chrono::seconds(IOTimeout) : NoDeadline;
+}
+
+std::atomic<bool> shutdownRequested(false);
+
+void handleSignal(int) { shutdownRequested = true; }
+
+// Waits until fd is ready for events, returns false when deadline passed.
+// Deadline is for whole message, so peer sending or reading it byte by byte
+// can't make it last longer.
+bool waitReady(int fd, short events, Clock::time_point deadline) {
+  int timeout = -1;
+  if (deadline != NoDeadline) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - Clock::now());
+    if (remaining.count() <= 0) return false;
+    timeout = int(std::min<int64_t>(remaining.count(), INT_MAX));
+  }
+  pollfd pfd = {fd, events, 0};
+  int n = ::poll(&pfd, 1, timeout);
+  // Interrupted wait is retried by caller with remaining time
+  return n > 0 || (n < 0 && errno == EINTR);
+}
+
+bool readAll(int fd, void *buffer, size_t size, Clock::time_point deadline) {
+  char *p = static_cast<char *>(buffer);
+  while (size) {
+    if (!waitReady(fd, POLLIN, deadline)) return false;
+    ssize_t n = ::read(fd, p, size);
+    if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool writeAll(int fd, const void *buffer, size_t size, Clock::time_point deadline) {
+  const char *p = static_cast<const char *>(buffer);
+  while (size) {
+    if (!waitReady(fd, POLLOUT, deadline)) return false;
+    ssize_t n = ::write(fd, p, size);
+    if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool writeMessage(int fd, char kind, StringRef payload, Clock::time_point deadline) {
+  uint64_t size = payload.size();
+  return writeAll(fd, &kind, 1, deadline) &&
+         writeAll(fd, &size, sizeof(size), deadline) &&
+         writeAll(fd, payload.data(), payload.size(), deadline);
+}
+
+bool readHeader(int fd, char &kind, uint64_t &size, Clock::time_point deadline) {
+  return readAll(fd, &kind, 1, deadline) && readAll(fd, &size, sizeof(size), deadline);
+}
+
+bool readPayload(int fd, uint64_t size, std::string &payload, Clock::time_point deadline) {
+  payload.clear();
+  while (payload.size() < size) {
+    size_t offset = payload.size();
+    size_t chunk = std::min<uint64_t>(PayloadChunkSize, size - offset);
+    payload.resize(offset + chunk);
+    if (!readAll(fd, &payload[offset], chunk, deadline)) return false;
+  }
+  return true;
+}
+
+bool readMessage(int fd, char &kind, std::string &payload, Clock::time_point deadline) {
+  uint64_t size;
+  return readHeader(fd, kind, size, deadline) && readPayload(fd, size, payload, deadline);
+}
+
+// Least recently used responses, keyed by request kind and module hash
+class ResponseCache {
+  std::mutex mutex;
+  std::list<std::pair<std::string, std::shared_ptr<const std::string>>> entries;
+  std::unordered_map<std::string, decltype(entries)::iterator> index;
+
+public:
+  std::shared_ptr<const std::string> lookup(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it == index.end()) return nullptr;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->second;
+  }
+
+  void insert(const std::string &key, std::shared_ptr<const std::string> response) {
+    if (!CacheSize) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.count(key)) return;
+    entries.emplace_front(key, std::move(response));
+    index[key] = entries.begin();
+    if (entries.size() > CacheSize) {
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+  }
+};
+
+class LatencyStats {
+  std::mutex mutex;
+  std::vector<double> latencies;
+  size_t next = 0;
+  uint64_t requests = 0;
+  uint64_t cacheHits = 0;
+  uint64_t errors = 0;
+
+public:
+  void add(double milliseconds, bool cacheHit, bool error) {
+    std::lock_guard<std::mutex> lock(mutex);
+    requests++;
+    cacheHits += cacheHit;
+    errors += error;
+    if (latencies.size() < LatencyWindow) {
+      latencies.push_back(milliseconds);
+    } else {
+      latencies[next] = milliseconds;
+      next = (next + 1) % LatencyWindow;
+    }
+  }
+
+  json::Object makeJson() {
+    std::vector<double> sorted;
+    json::Object statsJson;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      sorted = latencies;
+      statsJson["requests"] = int64_t(requests);
+      statsJson["cache_hits"] = int64_t(cacheHits);
+      statsJson["errors"] = int64_t(errors);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p) -> double {
+      if (sorted.empty()) return 0;
+      return sorted[std::min(sorted.size() - 1, size_t(p * sorted.size()))];
+    };
+    statsJson["p50_ms"] = percentile(0.5);
+    statsJson["p90_ms"] = percentile(0.9);
+    statsJson["p99_ms"] = percentile(0.99);
+    statsJson["max_ms"] = sorted.empty() ? 0.0 : sorted.back();
+    return statsJson;
+  }
+};
+
+class Worker {
+  PassBuilder PB;
+  ResponseCache &cache;
+  LatencyStats &stats;
+
+  // Analyzes module in payload, returns false and error message on failure
+  bool analyze(StringRef payload, bool pretty, std::string &response) {
+    LLVMContext context;
+    SMDiagnostic err;
+    std::unique_ptr<Module> M = parseIR(
+        MemoryBufferRef(payload, "<request>"), err, context);
+    if (!M) {
+      raw_string_ostream OS(response);
+      err.print("program-complexity-daemon", OS);
+      return false;
+    }
+
+    // Parser does not verify module, analysis assumes valid IR
+    bool brokenDebugInfo = false;
+    {
+      raw_string_ostream OS(response);
+      if (verifyModule(*M, &OS, &brokenDebugInfo)) return false;
+    }
+    if (brokenDebugInfo) {
+      // Same as opt does, functions are then skipped for missing debug info
+      StripDebugInfo(*M);
+    }
+    response.clear();
+
+    LoopAnalysisManager LAM;
+    FunctionAnalysisManager FAM;
+    CGSCCAnalysisManager CGAM;
+    ModuleAnalysisManager MAM;
+    FAM.registerPass([&] { return ProgramComplexity(); });
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    raw_string_ostream OS(response);
+    for (Function &F : *M) {
+      if (F.isDeclaration()) continue;
+
+      // Analysis itself skips functions without required debug info
+      ProgramComplexity::Result result = FAM.getResult<ProgramComplexity>(F);
+      if (result->skipped) errs() << "Skipped function " << F.getName() << "\n";
+
+      json::OStream JOS(OS, /*PrettyPrint*/ pretty ? 1 : 0);
+      JOS.value(std::move(result->makeJson()));
+      OS << '\n';
+    }
+    OS.flush();
+    return true;
+  }
+
+public:
+  Worker(ResponseCache &cache, LatencyStats &stats)
+      : cache(cache), stats(stats) {}
+
+  // Answers single request waiting on connection, returns false when
+  // connection has to be closed
+  bool serveRequest(int fd) {
+    char kind;
+    uint64_t size;
+    std::string payload;
+    // Request is pending already, whole of it has to come until deadline
+    Clock::time_point deadline = ioDeadline();
+    if (!readHeader(fd, kind, size, deadline)) return false;
+
+    if (size > MaxRequestSize) {
+      // Payload is left unread, so connection can't be used any more
+      stats.add(0, false, true);
+      writeMessage(fd, ResponseError,
+                   "request of " + utostr(size) + " bytes exceeds limit of " +
+                       utostr(MaxRequestSize) + " bytes",
+                   ioDeadline());
+      return false;
+    }
+    if (!readPayload(fd, size, payload, deadline)) return false;
+
+    if (kind == RequestStats) {
+      std::string statsStr;
+      raw_string_ostream OS(statsStr);
+      OS << json::Value(stats.makeJson());
+      return writeMessage(fd, ResponseOk, OS.str(), ioDeadline());
+    }
+
+    if (kind != RequestPrettyJson && kind != RequestCompactJson) {
+      writeMessage(fd, ResponseError, "unknown request kind", ioDeadline());
+      return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    MD5 hash;
+    hash.update(payload);
+    MD5::MD5Result hashResult;
+    hash.final(hashResult);
+    std::string key = std::string(1, kind) + hashResult.digest().str().str();
+
+    bool ok = true;
+    std::shared_ptr<const std::string> response = cache.lookup(key);
+    bool cacheHit = response != nullptr;
+    if (!cacheHit) {
+      std::string responseStr;
+      ok = analyze(payload, kind == RequestPrettyJson, responseStr);
+      response = std::make_shared<const std::string>(std::move(responseStr));
+      if (ok) cache.insert(key, response);
+    }
+
+    std::chrono::duration<double, std::milli> latency =
+        std::chrono::steady_clock::now() - startTime;
+    stats.add(latency.count(), cacheHit, !ok);
+
+    return writeMessage(fd, ok ? ResponseOk : ResponseError, *response, ioDeadline());
+  }
+};
+
+// Hands connections with pending request to workers. Connections between
+// requests are polled by acceptor thread, so idle clients don't hold workers.
+class Dispatcher {
+  std::mutex mutex;
+  std::condition_variable readyCondition;
+  // Connections with request waiting to be read
+  std::deque<int> ready;
+  // Connections handed back by workers after their request was answered
+  std::vector<int> returned;
+  // Connections polled by acceptor
+  std::vector<int> idle;
+  // Wakes acceptor poll when connection is handed back
+  int wakeFds[2] = {-1, -1};
+
+public:
+  ~Dispatcher() {
+    for (int fd : ready) ::close(fd);
+    for (int fd : returned) ::close(fd);
+    for (int fd : idle) ::close(fd);
+    for (int fd : wakeFds)
+      if (fd >= 0) ::close(fd);
+  }
+
+  bool init() {
+    if (::pipe(wakeFds)) return false;
+    for (int fd : wakeFds) ::fcntl(fd, F_SETFL, O_NONBLOCK);
+    return true;
+  }
+
+  // Worker side, waits for connection with pending request, returns false
+  // on shutdown
+  bool next(int &fd) {
+    std::unique_lock<std::mutex> lock(mutex);
+    readyCondition.wait(lock, [&]() { return shutdownRequested || !ready.empty(); });
+    if (ready.empty()) return false;
+    fd = ready.front();
+    ready.pop_front();
+    return true;
+  }
+
+  // Worker side, connection waits for its next request again
+  void giveBack(int fd) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      returned.push_back(fd);
+    }
+    // Pipe full means acceptor is woken already
+    char wake = 0;
+    ssize_t written = ::write(wakeFds[1], &wake, 1);
+    (void)written;
+  }
+
+  // Acceptor side, runs until shutdown request
+  void run(int listenFd) {
+    std::vector<pollfd> pfds;
+    while (!shutdownRequested) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle.insert(idle.end(), returned.begin(), returned.end());
+        returned.clear();
+      }
+
+      pfds.clear();
+      pfds.push_back({listenFd, POLLIN, 0});
+      pfds.push_back({wakeFds[0], POLLIN, 0});
+      for (int fd : idle) pfds.push_back({fd, POLLIN, 0});
+
+      // Poll with timeout, so signal can stop accept loop
+      if (::poll(pfds.data(), pfds.size(), 200) <= 0) continue;
+
+      if (pfds[1].revents) {
+        char drain[64];
+        while (::read(wakeFds[0], drain, sizeof(drain)) > 0) {
+        }
+      }
+
+      // Hang up and errors are queued too, worker closes such connection
+      std::vector<int> stillIdle;
+      unsigned readyCount = 0;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 2; i < pfds.size(); i++) {
+          if (pfds[i].revents) {
+            ready.push_back(pfds[i].fd);
+            readyCount++;
+          } else {
+            stillIdle.push_back(pfds[i].fd);
+          }
+        }
+      }
+      idle.swap(stillIdle);
+      for (unsigned i = 0; i < readyCount; i++) readyCondition.notify_one();
+
+      if (pfds[0].revents & POLLIN) {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd >= 0) {
+          // Workers wait for data with deadline, read and write never block
+          ::fcntl(fd, F_SETFL, O_NONBLOCK);
+          idle.push_back(fd);
+        }
+      }
+    }
+    readyCondition.notify_all();
+  }
+};
+
+int listenOnSocket() {
+  if (SocketPath.size() >= sizeof(sockaddr_un::sun_path)) {
+    WithColor::error() << "socket path too long: " << SocketPath << "\n";
+    return -1;
+  }
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, SocketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+  // Remove socket left by daemon which did not shut down cleanly, but never
+  // other files or socket of daemon still running
+  struct stat st;
+  if (::lstat(SocketPath.c_str(), &st) == 0) {
+    if (!S_ISSOCK(st.st_mode)) {
+      WithColor::error() << SocketPath << " exists and is not a socket\n";
+      return -1;
+    }
+    int probeFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    bool alive = probeFd >= 0 &&
+                 !::connect(probeFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    if (probeFd >= 0) ::close(probeFd);
+    if (alive) {
+      WithColor::error() << "another daemon is listening on " << SocketPath << "\n";
+      return -1;
+    }
+    ::unlink(SocketPath.c_str());
+  }
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ||
+      ::listen(fd, SOMAXCONN)) {
+    WithColor::error() << "can't listen on " << SocketPath << ": "
+                       << strerror(errno) << "\n";
+    return -1;
+  }
+  return fd;
+}
+
+int connectToSocket() {
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, SocketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))) {
+    WithColor::error() << "can't connect to " << SocketPath << ": "
+                       << strerror(errno) << "\n";
+    return -1;
+  }
+  return fd;
+}
+
+int runClient() {
+  std::string payload;
+  char kind = RequestStats;
+  if (!Stats) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> buffer = MemoryBuffer::getFileOrSTDIN(RequestFile);
+    if (!buffer) {
+      WithColor::error() << "can't open " << RequestFile << ": "
+                         << buffer.getError().message() << "\n";
+      return 1;
+    }
+    payload = (*buffer)->getBuffer().str();
+    kind = CompactJson ? RequestCompactJson : RequestPrettyJson;
+  }
+
+  int fd = connectToSocket();
+  if (fd < 0) return 1;
+
+  // Daemon may refuse request before reading all of it, its answer is still
+  // worth reading when write fails
+  char status;
+  std::string response;
+  writeMessage(fd, kind, payload, NoDeadline);
+  if (!readMessage(fd, status, response, NoDeadline)) {
+    WithColor::error() << "connection to daemon lost\n";
+    return 1;
+  }
+  ::close(fd);
+
+  if (status != ResponseOk) {
+    WithColor::error() << response << "\n";
+    return 1;
+  }
+  outs() << response;
+  if (Stats) outs() << "\n";
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::ParseCommandLineOptions(argc, argv, "ProgramComplexity analysis daemon\n");
+
+  std::signal(SIGPIPE, SIG_IGN);
+  if (Stats || !RequestFile.empty()) return runClient();
+
+  std::signal(SIGINT, handleSignal);
+  std::signal(SIGTERM, handleSignal);
+
+  int listenFd = listenOnSocket();
+  if (listenFd < 0) return 1;
+
+  ResponseCache cache;
+  LatencyStats stats;
+  Dispatcher dispatcher;
+  if (!dispatcher.init()) {
+    WithColor::error() << "can't create pipe: " << strerror(errno) << "\n";
+    return 1;
+  }
+
+  unsigned workerCount = Workers ? Workers.getValue()
+                                 : hardware_concurrency().compute_thread_count();
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < workerCount; i++) {
+    threads.emplace_back([&]() {
+      Worker worker(cache, stats);
+      int fd;
+      while (dispatcher.next(fd)) {
+        if (worker.serveRequest(fd))
+          dispatcher.giveBack(fd);
+        else
+          ::close(fd);
+      }
+    });
+  }
+
+  errs() << "Listening on " << SocketPath << " with " << workerCount << " workers\n";
+
+  dispatcher.run(listenFd);
+
+  for (std::thread &t : threads) t.join();
+  ::close(listenFd);
+  ::unlink(SocketPath.c_str());
+
+  errs() << json::Value(stats.makeJson()) << "\n";
+  return 0;
+}
@@ -0,0 +1,703 @@
+// Structural diff between two ProgramComplexity outputs.
+//
+// Inputs are files with pass output, that is sequence of top level json
+// function objects as printed by print-program-complexity pass. Functions are
+// matched by name, functions sharing name in order of appearance, loops and
+// blocks by name or, when renamed, by debug location. Changes to opcode
+// histograms, loop trip count expressions and called functions are reported,
+// functions ranked by estimated cost delta.
+//
+// Both inputs are memory mapped. First input is only scanned to index
+// function spans, functions are then parsed one batch at a time, so memory use
+// is bounded by batch size instead of input size.
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static cl::opt<std::string> OldFile(cl::Positional, cl::Required,
+                                    cl::desc("<old output.json>"));
+static cl::opt<std::string> NewFile(cl::Positional, cl::Required,
+                                    cl::desc("<new output.json>"));
+
+static cl::opt<unsigned> TopFunctions(
+    "top", cl::init(50),
+    cl::desc("Number of functions with biggest cost delta to report, 0 "
+             "reports all changed functions."));
+
+static cl::opt<double> UnknownTripCount(
+    "unknown-trip-count", cl::init(16),
+    cl::desc("Trip count assumed for loops with non constant iteration count, "
+             "when estimating cost."));
+
+static cl::opt<unsigned> Jobs("j", cl::init(0),
+                              cl::desc("Number of threads, 0 uses all cores."));
+
+static cl::opt<unsigned> BatchSize(
+    "batch-size", cl::init(1024), cl::Hidden,
+    cl::desc("Number of functions parsed and diffed at once."));
+
+namespace {
+
+// Spans of top level function objects with the same name in old input, in
+// input order. Static functions of concatenated outputs of several translation
+// units can share name, they are paired with new ones by occurrence index.
+struct FunctionSpans {
+  std::vector<StringRef> texts;
+  // Occurrences of name seen so far in new input
+  size_t newOccurrences = 0;
+};
+
+// Loop or block identity used when its name changed between inputs
+struct Located {
+  // "line:column" of block terminator, for loop the one of its header block
+  std::string location;
+  // Locations of enclosing loops, outermost first
+  std::string loopPath;
+  // loopPath and location, suffixed by occurrence index among parts with
+  // same loopPath and location, so inlined or unrolled copies sharing
+  // location are told apart. Empty when location is unknown.
+  std::string matchKey;
+};
+
+struct BlockSummary : Located {
+  std::map<std::string, int64_t> opcodes;
+  // Calls by callee, weighted by call probability, so indirect call with
+  // several candidate callees counts as one call
+  std::map<std::string, double> calls;
+  double weight = 1;
+
+  double cost() const {
+    double count = 0;
+    for (auto const &[opcode, n] : opcodes) count += n;
+    for (auto const &[callee, n] : calls) count += n;
+    return weight * count;
+  }
+};
+
+struct LoopSummary : Located {
+  std::string iterations;
+};
+
+struct FunctionSummary {
+  std::map<std::string, BlockSummary> blocks;
+  std::map<std::string, LoopSummary> loops;
+  // Names in output order, occurrence indexes of match keys follow it
+  std::vector<std::string> blockOrder;
+  std::vector<std::string> loopOrder;
+  double cost = 0;
+  bool valid = true;
+  // Function not analyzed by budgeted printer
+  bool skipped = false;
+};
+
+struct FunctionDiff {
+  std::string name;
+  double oldCost = 0;
+  double newCost = 0;
+  std::string report;
+  bool skipped = false;
+
+  double delta() const { return newCost - oldCost; }
+};
+
+// Calls callback for every top level json object in buffer, together with its
+// "name" member. Text outside of objects (ex. debug output) is skipped.
+void scanObjects(StringRef buffer,
+                 function_ref<void(StringRef object, StringRef name)> callback) {
+  size_t size = buffer.size();
+  const char *data = buffer.data();
+  size_t i = 0;
+
+  while (i < size) {
+    // Find start of next top level object
+    while (i < size && data[i] != '{') i++;
+    if (i == size) return;
+
+    size_t begin = i;
+    int depth = 0;
+    StringRef lastString;
+    StringRef name;
+    bool nameFollows = false;
+
+    for (; i < size; i++) {
+      char c = data[i];
+      if (c == '"') {
+        size_t strBegin = ++i;
+        while (i < size && data[i] != '"') {
+          if (data[i] == '\\') i++;
+          i++;
+        }
+        lastString = StringRef(data + strBegin, std::min(i, size) - strBegin);
+        if (nameFollows) {
+          name = lastString;
+          nameFollows = false;
+        }
+      } else if (c == ':') {
+        nameFollows = depth == 1 && name.empty() && lastString == "name";
+      } else if (c == '{' || c == '[') {
+        depth++;
+      } else if (c == '}' || c == ']') {
+        if (--depth == 0) break;
+      }
+    }
+
+    if (i == size) {
+      WithColor::warning() << "truncated json object at offset " << begin << "\n";
+      return;
+    }
+    i++;
+    callback(StringRef(data + begin, i - begin), name);
+  }
+}
+
+// Minimal pull reader for pass output. Only fields used by diff are read,
+// everything else is skipped without building json values, which is much
+// faster than full json::parse for big inputs. Strings are kept raw, escapes
+// are not decoded.
+class JsonReader {
+  const char *p;
+  const char *end;
+  bool failed = false;
+
+public:
+  explicit JsonReader(StringRef text) : p(text.begin()), end(text.end()) {}
+
+  bool hasFailed() const { return failed; }
+  const char *position() const { return p; }
+
+  void skipWhitespace() {
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\t' || *p == '\r')) p++;
+  }
+
+  bool expect(char c) {
+    skipWhitespace();
+    if (p < end && *p == c) {
+      p++;
+      return true;
+    }
+    failed = true;
+    return false;
+  }
+
+  StringRef string() {
+    if (!expect('"')) return StringRef();
+    const char *begin = p;
+    while (p < end && *p != '"') p += (*p == '\\') ? 2 : 1;
+    if (p >= end) {
+      failed = true;
+      return StringRef();
+    }
+    return StringRef(begin, p++ - begin);
+  }
+
+  int64_t integer() {
+    skipWhitespace();
+    const char *begin = p;
+    while (p < end && (isDigit(*p) || *p == '-')) p++;
+    int64_t value = 0;
+    if (StringRef(begin, p - begin).getAsInteger(10, value)) failed = true;
+    return value;
+  }
+
+  void skipValue() {
+    skipWhitespace();
+    if (p >= end) {
+      failed = true;
+      return;
+    }
+    if (*p == '"') {
+      string();
+      return;
+    }
+    if (*p != '{' && *p != '[') {
+      // Number or literal
+      while (p < end && *p != ',' && *p != '}' && *p != ']') p++;
+      return;
+    }
+    int depth = 0;
+    for (; p < end; p++) {
+      if (*p == '"') {
+        string();
+        p--;
+      } else if (*p == '{' || *p == '[') {
+        depth++;
+      } else if ((*p == '}' || *p == ']') && --depth == 0) {
+        p++;
+        return;
+      }
+    }
+    failed = true;
+  }
+
+  // Calls onKey for every member, onKey has to read or skip member value
+  void object(function_ref<void(StringRef key)> onKey) {
+    if (!expect('{')) return;
+    skipWhitespace();
+    if (p < end && *p == '}') {
+      p++;
+      return;
+    }
+    do {
+      StringRef key = string();
+      if (!expect(':')) return;
+      onKey(key);
+      skipWhitespace();
+    } while (!failed && p < end && *p++ == ',');
+    if (p[-1] != '}') failed = true;
+  }
+
+  // Calls onElement for every element, onElement has to read or skip it
+  void array(function_ref<void()> onElement) {
+    if (!expect('[')) return;
+    skipWhitespace();
+    if (p < end && *p == ']') {
+      p++;
+      return;
+    }
+    do {
+      onElement();
+      skipWhitespace();
+    } while (!failed && p < end && *p++ == ',');
+    if (p[-1] != ']') failed = true;
+  }
+};
+
+double tripCount(StringRef iterations, StringRef maxIterations) {
+  // Iterations are backedge taken count, trip count is one more
+  uint64_t backedgeTakenCount;
+  if (!iterations.getAsInteger(10, backedgeTakenCount))
+    return double(backedgeTakenCount) + 1;
+  // Unknown trip count is still limited by constant maximum
+  if (!maxIterations.getAsInteger(10, backedgeTakenCount))
+    return std::min(double(UnknownTripCount), double(backedgeTakenCount) + 1);
+  return UnknownTripCount;
+}
+
+void summarizeChildren(StringRef children, double weight, FunctionSummary &summary);
+
+void summarizePart(JsonReader &reader, double weight, FunctionSummary &summary) {
+  StringRef type, name, iterations = "Undef", maxIterations = "Undef", children;
+  StringRef line = "Undef", column = "Undef";
+  std::map<std::string, int64_t> opcodes;
+  std::map<std::string, double> calls;
+
+  reader.object([&](StringRef key) {
+    if (key == "type") {
+      type = reader.string();
+    } else if (key == "name") {
+      name = reader.string();
+    } else if (key == "iterations") {
+      iterations = reader.string();
+    } else if (key == "iterations_bounds") {
+      reader.object([&](StringRef boundsKey) {
+        if (boundsKey != "constant_max") {
+          reader.skipValue();
+          return;
+        }
+        reader.object([&](StringRef boundKey) {
+          if (boundKey == "iterations") maxIterations = reader.string();
+          else reader.skipValue();
+        });
+      });
+    } else if (key == "children") {
+      // Keys are sorted, children precede iterations, so they are read later
+      reader.skipWhitespace();
+      const char *begin = reader.position();
+      reader.skipValue();
+      children = StringRef(begin, reader.position() - begin);
+    } else if (key == "instructions") {
+      reader.array([&]() {
+        StringRef opcode;
+        int64_t count = 0;
+        reader.object([&](StringRef instKey) {
+          if (instKey == "instruction") opcode = reader.string();
+          else if (instKey == "count") count = reader.integer();
+          else reader.skipValue();
+        });
+        opcodes[opcode.str()] += count;
+      });
+    } else if (key == "function calls") {
+      reader.array([&]() {
+        StringRef callee;
+        double probability = 1;
+        reader.object([&](StringRef callKey) {
+          if (callKey == "function") {
+            reader.object([&](StringRef functionKey) {
+              if (functionKey == "name") callee = reader.string();
+              else reader.skipValue();
+            });
+          } else if (callKey == "probability") {
+            // Outputs without call probability count every call once
+            if (reader.string().getAsDouble(probability)) probability = 1;
+          } else {
+            reader.skipValue();
+          }
+        });
+        calls[callee.str()] += probability;
+      });
+    } else if (key == "terminator_dbg_location") {
+      reader.object([&](StringRef locKey) {
+        if (locKey == "line") line = reader.string();
+        else if (locKey == "column") column = reader.string();
+        else reader.skipValue();
+      });
+    } else {
+      reader.skipValue();
+    }
+  });
+
+  if (type == "loop") {
+    size_t firstBlock = summary.blockOrder.size();
+    size_t firstLoop = summary.loopOrder.size();
+    if (!children.empty())
+      summarizeChildren(children, weight * tripCount(iterations, maxIterations), summary);
+
+    LoopSummary &loop = summary.loops[name.str()];
+    loop.iterations = iterations.str();
+    // Loop is named after its header block, which is its direct child
+    auto header = summary.blocks.find(name.str());
+    if (header != summary.blocks.end()) loop.location = header->second.location;
+
+    std::string prefix = (loop.location.empty() ? "?" : loop.location) + "/";
+    for (size_t i = firstBlock; i < summary.blockOrder.size(); i++)
+      summary.blocks[summary.blockOrder[i]].loopPath.insert(0, prefix);
+    for (size_t i = firstLoop; i < summary.loopOrder.size(); i++)
+      summary.loops[summary.loopOrder[i]].loopPath.insert(0, prefix);
+    summary.loopOrder.push_back(name.str());
+    return;
+  }
+
+  if (type != "basic block") return;
+
+  BlockSummary &block = summary.blocks[name.str()];
+  block.weight = weight;
+  block.opcodes = std::move(opcodes);
+  block.calls = std::move(calls);
+  if (line != "Undef") block.location = (line + ":" + column).str();
+  summary.blockOrder.push_back(name.str());
+  summary.cost += block.cost();
+}
+
+void summarizeChildren(StringRef children, double weight, FunctionSummary &summary) {
+  JsonReader reader(children);
+  reader.array([&]() { summarizePart(reader, weight, summary); });
+  if (reader.hasFailed()) summary.valid = false;
+}
+
+template <typename Part>
+void assignMatchKeys(const std::vector<std::string> &order,
+                     std::map<std::string, Part> &parts) {
+  std::map<std::string, unsigned> occurrences;
+  for (const std::string &name : order) {
+    Part &part = parts[name];
+    if (part.location.empty()) continue;
+    std::string key = part.loopPath + part.location;
+    part.matchKey = key + "#" + std::to_string(occurrences[key]++);
+  }
+}
+
+bool summarize(StringRef text, FunctionSummary &summary) {
+  JsonReader reader(text);
+  StringRef children;
+  reader.object([&](StringRef key) {
+    if (key == "skipped") {
+      reader.skipWhitespace();
+      summary.skipped = reader.position()[0] == 't';
+    }
+    if (key != "children") {
+      reader.skipValue();
+      return;
+    }
+    reader.skipWhitespace();
+    const char *begin = reader.position();
+    reader.skipValue();
+    children = StringRef(begin, reader.position() - begin);
+  });
+  if (reader.hasFailed()) return false;
+
+  if (!children.empty()) summarizeChildren(children, 1, summary);
+  assignMatchKeys(summary.blockOrder, summary.blocks);
+  assignMatchKeys(summary.loopOrder, summary.loops);
+  return summary.valid;
+}
+
+void printCount(raw_ostream &OS, int64_t count) { OS << count; }
+
+void printCount(raw_ostream &OS, double count) { OS << format("%g", count); }
+
+template <typename Count>
+void diffHistogram(const std::map<std::string, Count> &oldH,
+                   const std::map<std::string, Count> &newH,
+                   raw_ostream &OS) {
+  auto oldIt = oldH.begin(), newIt = newH.begin();
+  while (oldIt != oldH.end() || newIt != newH.end()) {
+    if (newIt == newH.end() || (oldIt != oldH.end() && oldIt->first < newIt->first)) {
+      OS << " " << oldIt->first << " ";
+      printCount(OS, oldIt->second);
+      OS << "->0";
+      ++oldIt;
+    } else if (oldIt == oldH.end() || newIt->first < oldIt->first) {
+      OS << " " << newIt->first << " 0->";
+      printCount(OS, newIt->second);
+      ++newIt;
+    } else {
+      if (oldIt->second != newIt->second) {
+        OS << " " << oldIt->first << " ";
+        printCount(OS, oldIt->second);
+        OS << "->";
+        printCount(OS, newIt->second);
+      }
+      ++oldIt;
+      ++newIt;
+    }
+  }
+}
+
+void diffBlock(StringRef name, const BlockSummary *oldB,
+               const BlockSummary *newB, raw_ostream &OS) {
+  static const BlockSummary empty;
+  const BlockSummary &o = oldB ? *oldB : empty;
+  const BlockSummary &n = newB ? *newB : empty;
+
+  std::string changes;
+  raw_string_ostream changesOS(changes);
+  diffHistogram(o.opcodes, n.opcodes, changesOS);
+  std::string callChanges;
+  raw_string_ostream callsOS(callChanges);
+  diffHistogram(o.calls, n.calls, callsOS);
+
+  if (changesOS.str().empty() && callsOS.str().empty() && oldB && newB)
+    return;
+
+  const std::string &location = newB ? n.location : o.location;
+  OS << "    block " << name;
+  if (!location.empty()) OS << " [" << location << "]";
+  if (!oldB) OS << " added";
+  if (!newB) OS << " removed";
+  OS << format(" cost %+.1f", n.cost() - o.cost()) << "\n";
+  if (!changesOS.str().empty()) OS << "      opcodes:" << changesOS.str() << "\n";
+  if (!callsOS.str().empty()) OS << "      calls:" << callsOS.str() << "\n";
+}
+
+void diffLoop(StringRef name, const LoopSummary *oldL, const LoopSummary *newL,
+              raw_ostream &OS) {
+  if (oldL && newL && oldL->iterations == newL->iterations) return;
+
+  const std::string &location = newL ? newL->location : oldL->location;
+  OS << "    loop " << name;
+  if (!location.empty()) OS << " [" << location << "]";
+  if (!oldL)
+    OS << " added, iterations: " << newL->iterations;
+  else if (!newL)
+    OS << " removed";
+  else
+    OS << " iterations: " << oldL->iterations << " -> " << newL->iterations;
+  OS << "\n";
+}
+
+// Pairs parts by name first, then remaining ones by match key, calls onPair
+// with null for parts without counterpart
+template <typename Part>
+void matchParts(const std::map<std::string, Part> &oldParts,
+                const std::map<std::string, Part> &newParts,
+                function_ref<void(StringRef, const Part *, const Part *)> onPair) {
+  std::map<std::string, const std::pair<const std::string, Part> *> oldByKey;
+  std::vector<const std::pair<const std::string, Part> *> oldOnly;
+  for (auto const &entry : oldParts) {
+    auto it = newParts.find(entry.first);
+    if (it != newParts.end()) {
+      onPair(entry.first, &entry.second, &it->second);
+      continue;
+    }
+    oldOnly.push_back(&entry);
+    if (!entry.second.matchKey.empty()) oldByKey.emplace(entry.second.matchKey, &entry);
+  }
+
+  for (auto const &entry : newParts) {
+    if (oldParts.count(entry.first)) continue;
+    auto it = entry.second.matchKey.empty() ? oldByKey.end()
+                                            : oldByKey.find(entry.second.matchKey);
+    if (it == oldByKey.end()) {
+      onPair(entry.first, nullptr, &entry.second);
+      continue;
+    }
+    onPair(it->second->first + " -> " + entry.first, &it->second->second, &entry.second);
+    oldOnly.erase(std::find(oldOnly.begin(), oldOnly.end(), it->second));
+    oldByKey.erase(it);
+  }
+
+  for (auto *entry : oldOnly) onPair(entry->first, &entry->second, nullptr);
+}
+
+FunctionDiff diffFunctions(StringRef name, const FunctionSummary &o,
+                           const FunctionSummary &n) {
+  FunctionDiff diff;
+  diff.name = name.str();
+  diff.oldCost = o.cost;
+  diff.newCost = n.cost;
+
+  raw_string_ostream OS(diff.report);
+
+  matchParts<LoopSummary>(o.loops, n.loops,
+                          [&](StringRef loopName, const LoopSummary *oldL,
+                              const LoopSummary *newL) {
+                            diffLoop(loopName, oldL, newL, OS);
+                          });
+  matchParts<BlockSummary>(o.blocks, n.blocks,
+                           [&](StringRef blockName, const BlockSummary *oldB,
+                               const BlockSummary *newB) {
+                             diffBlock(blockName, oldB, newB, OS);
+                           });
+
+  OS.flush();
+  return diff;
+}
+
+// Keeps functions with biggest absolute cost delta
+class DiffRanking {
+  std::vector<FunctionDiff> diffs;
+  unsigned changedFunctions = 0;
+  unsigned skippedFunctions = 0;
+
+  static bool smallerDelta(const FunctionDiff &a, const FunctionDiff &b) {
+    return std::fabs(a.delta()) > std::fabs(b.delta());
+  }
+
+public:
+  void add(FunctionDiff diff) {
+    if (diff.skipped) {
+      skippedFunctions++;
+      return;
+    }
+    if (diff.report.empty() && diff.delta() == 0) return;
+    changedFunctions++;
+
+    diffs.push_back(std::move(diff));
+    std::push_heap(diffs.begin(), diffs.end(), smallerDelta);
+    if (TopFunctions && diffs.size() > TopFunctions) {
+      std::pop_heap(diffs.begin(), diffs.end(), smallerDelta);
+      diffs.pop_back();
+    }
+  }
+
+  void print(raw_ostream &OS) {
+    std::sort_heap(diffs.begin(), diffs.end(), smallerDelta);
+    OS << changedFunctions << " changed functions";
+    if (changedFunctions > diffs.size()) OS << ", showing top " << diffs.size();
+    if (skippedFunctions)
+      OS << ", " << skippedFunctions << " functions skipped in one of inputs";
+    OS << "\n";
+
+    for (const FunctionDiff &diff : diffs) {
+      OS << format("%+.1f", diff.delta()) << " " << diff.name
+         << format(" (cost %.1f -> %.1f)", diff.oldCost, diff.newCost) << "\n";
+      OS << diff.report;
+    }
+  }
+};
+
+std::unique_ptr<MemoryBuffer> openInput(StringRef path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> buffer =
+      MemoryBuffer::getFile(path, /*IsText*/ false,
+                            /*RequiresNullTerminator*/ false);
+  if (!buffer) {
+    WithColor::error() << "can't open " << path << ": "
+                       << buffer.getError().message() << "\n";
+    exit(1);
+  }
+  return std::move(*buffer);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  cl::ParseCommandLineOptions(argc, argv,
+                              "Structural diff of ProgramComplexity outputs\n");
+
+  std::unique_ptr<MemoryBuffer> oldBuffer = openInput(OldFile);
+  std::unique_ptr<MemoryBuffer> newBuffer = openInput(NewFile);
+
+  // Index old functions, without parsing them
+  StringMap<FunctionSpans> oldFunctions;
+  scanObjects(oldBuffer->getBuffer(), [&](StringRef object, StringRef name) {
+    oldFunctions[name].texts.push_back(object);
+  });
+
+  // Name shown in report, later occurrences of same name get their index
+  auto occurrenceName = [](StringRef name, size_t occurrence) {
+    std::string shownName = name.str();
+    if (occurrence) shownName += "#" + std::to_string(occurrence);
+    return shownName;
+  };
+
+  ThreadPool pool(hardware_concurrency(Jobs));
+  DiffRanking ranking;
+
+  // Diff batch of function pairs in parallel. Any side of pair can be missing.
+  std::vector<std::pair<std::string, std::pair<StringRef, StringRef>>> batch;
+  auto flushBatch = [&]() {
+    std::vector<FunctionDiff> results(batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+      pool.async([&, i]() {
+        auto const &[name, texts] = batch[i];
+        if (texts.first == texts.second) return;
+
+        FunctionSummary o, n;
+        if (!texts.first.empty() && !summarize(texts.first, o))
+          WithColor::warning() << "can't parse old function " << name << "\n";
+        if (!texts.second.empty() && !summarize(texts.second, n))
+          WithColor::warning() << "can't parse new function " << name << "\n";
+
+        if (o.skipped || n.skipped) {
+          results[i].skipped = true;
+          return;
+        }
+
+        results[i] = diffFunctions(name, o, n);
+        if (texts.first.empty()) results[i].report.insert(0, "    function added\n");
+        if (texts.second.empty()) results[i].report.insert(0, "    function removed\n");
+      });
+    }
+    pool.wait();
+
+    for (FunctionDiff &diff : results) ranking.add(std::move(diff));
+    batch.clear();
+  };
+
+  scanObjects(newBuffer->getBuffer(), [&](StringRef object, StringRef name) {
+    FunctionSpans &spans = oldFunctions[name];
+    size_t occurrence = spans.newOccurrences++;
+    StringRef oldText = occurrence < spans.texts.size() ? spans.texts[occurrence] : StringRef();
+    batch.push_back({occurrenceName(name, occurrence), {oldText, object}});
+    if (batch.size() >= BatchSize) flushBatch();
+  });
+
+  for (auto &entry : oldFunctions) {
+    FunctionSpans &spans = entry.second;
+    for (size_t i = spans.newOccurrences; i < spans.texts.size(); i++) {
+      batch.push_back({occurrenceName(entry.first(), i), {spans.texts[i], StringRef()}});
+      if (batch.size() >= BatchSize) flushBatch();
+    }
+  }
+  flushBatch();
+
+  ranking.print(outs());
+  return 0;
+}